@@ -1,6 +1,50 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "ActionPrototype.h"
+#include "HAL/LowLevelMemStats.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ActionPrototype, "ActionPrototype" );
+DEFINE_LOG_CATEGORY(LogActionPrototype);
+
+DEFINE_STAT(STAT_GameplayTimersSet);
+
+CSV_DEFINE_CATEGORY_MODULE(ACTIONPROTOTYPE_API, GameplayAI, true);
+CSV_DEFINE_CATEGORY_MODULE(ACTIONPROTOTYPE_API, GameplayCombat, true);
+CSV_DEFINE_CATEGORY_MODULE(ACTIONPROTOTYPE_API, GameplayResources, true);
+CSV_DEFINE_CATEGORY_MODULE(ACTIONPROTOTYPE_API, GameplayInteractables, true);
+CSV_DEFINE_CATEGORY_MODULE(ACTIONPROTOTYPE_API, GameplaySpawning, true);
+
+UE_TRACE_CHANNEL_DEFINE(ActionPrototypeChannel);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DECLARE_LLM_MEMORY_STAT(TEXT("Enemies"), STAT_EnemiesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Pickups"), STAT_PickupsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Weapons"), STAT_WeaponsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("HUD"), STAT_HUDLLM, STATGROUP_LLMFULL);
+
+static void RegisterLLMTag(const EActionPrototypeLLMTag Tag, const TCHAR* Name, const FName StatName)
+{
+	FLowLevelMemTracker::Get().RegisterProjectTag(
+												  static_cast<int32>(ELLMTag::ProjectTagStart) + static_cast<int32>(Tag),
+												  Name,
+												  StatName,
+												  NAME_None
+												 );
+}
+#endif
+
+class FActionPrototypeModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		RegisterLLMTag(EActionPrototypeLLMTag::Enemies, TEXT("Enemies"), GET_STATFNAME(STAT_EnemiesLLM));
+		RegisterLLMTag(EActionPrototypeLLMTag::Pickups, TEXT("Pickups"), GET_STATFNAME(STAT_PickupsLLM));
+		RegisterLLMTag(EActionPrototypeLLMTag::Weapons, TEXT("Weapons"), GET_STATFNAME(STAT_WeaponsLLM));
+		RegisterLLMTag(EActionPrototypeLLMTag::HUD, TEXT("HUD"), GET_STATFNAME(STAT_HUDLLM));
+#endif
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FActionPrototypeModule, ActionPrototype, "ActionPrototype" );
@@ -3,4 +3,52 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/MiscTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
 
+ACTIONPROTOTYPE_API DECLARE_LOG_CATEGORY_EXTERN(LogActionPrototype, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("ActionPrototype"), STATGROUP_ActionPrototype, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gameplay Timers Set"), STAT_GameplayTimersSet, STATGROUP_ActionPrototype, ACTIONPROTOTYPE_API);
+
+/** CSV profiler categories of gameplay systems, captured with -csvCategories or csvprofile start. */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ACTIONPROTOTYPE_API, GameplayAI);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ACTIONPROTOTYPE_API, GameplayCombat);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ACTIONPROTOTYPE_API, GameplayResources);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ACTIONPROTOTYPE_API, GameplayInteractables);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ACTIONPROTOTYPE_API, GameplaySpawning);
+
+/** Gameplay scopes in Unreal Insights of builds without stats, enabled with -trace=cpu,actionprototype. */
+UE_TRACE_CHANNEL_EXTERN(ActionPrototypeChannel, ACTIONPROTOTYPE_API);
+
+/**
+ * Cycle counter of STATGROUP_ActionPrototype. The stat scope is already traced as a CPU event while stats are compiled in,
+ * builds without stats trace the scope on ActionPrototypeChannel instead.
+ */
+#if STATS
+#define AP_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define AP_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, ActionPrototypeChannel)
+#endif
+
+/** LLM tags of gameplay allocations, shown by stat LLMFULL and ap.Memory.Report when started with -llm. */
+enum class EActionPrototypeLLMTag : uint8
+{
+	Enemies,
+	Pickups,
+	Weapons,
+	HUD,
+	Max
+};
+
+/** Tags allocations of the scope with the given EActionPrototypeLLMTag, they're registered as project LLM tags. */
+#define AP_LLM_SCOPE(Tag) \
+	LLM_SCOPE(static_cast<ELLMTag>(static_cast<int32>(ELLMTag::ProjectTagStart) + static_cast<int32>(EActionPrototypeLLMTag::Tag)))
+
+/** Marks a gameplay event on the Insights timeline, enabled with -trace=bookmark. */
+#define AP_TRACE_EVENT(Format, ...) TRACE_BOOKMARK(Format, ##__VA_ARGS__)
@@ -3,6 +3,11 @@
 
 #include "BaseResourceComponent.h"
 
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Resource Change"), STAT_ResourceChange, STATGROUP_ActionPrototype);
 
 // Sets default values for this component's properties
 UBaseResourceComponent::UBaseResourceComponent()
@@ -10,6 +15,7 @@ UBaseResourceComponent::UBaseResourceComponent()
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 	// ...
 }
@@ -31,6 +37,7 @@ void UBaseResourceComponent::BeginPlay()
 	}
 	
 	Super::BeginPlay();
+	UTickPolicySubsystem::ApplyTickPolicy(this);
 }
 
 
@@ -40,9 +47,8 @@ void UBaseResourceComponent::TickComponent(
 	ELevelTick TickType,
 	FActorComponentTickFunction* ThisTickFunction)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	// ...
 }
 
 float UBaseResourceComponent::GetCurrentValue() const
@@ -57,6 +63,8 @@ float UBaseResourceComponent::GetMaxValue() const
 
 void UBaseResourceComponent::IncreaseValue(const float Amount, const bool bClampToMax)
 {
+	AP_SCOPE_BUDGET(Resources, ResourceChange, this);
+
 	if (bClampToMax && CurrentValue >= MaxValue)
 	{
 		return;
@@ -77,8 +85,26 @@ void UBaseResourceComponent::IncreaseValue(const float Amount, const bool bClamp
 	}
 }
 
+void UBaseResourceComponent::SetCurrentValue(const float NewValue)
+{
+	RestoreValues(MaxValue, NewValue);
+}
+
+void UBaseResourceComponent::RestoreValues(const float NewMaxValue, const float NewCurrentValue)
+{
+	MaxValue = FMath::Max(NewMaxValue, 0.f);
+	CurrentValue = FMath::Clamp(NewCurrentValue, 0.f, MaxValue);
+
+	if (bAutoChange && !IsCurrentValueOutOfBounds())
+	{
+		ProcessAutoChange();
+	}
+}
+
 void UBaseResourceComponent::DecreaseValue(const float Amount)
 {
+	AP_SCOPE_BUDGET(Resources, ResourceChange, this);
+
 	if (CurrentValue <= 0.f)
 	{
 		return;
@@ -96,6 +122,8 @@ void UBaseResourceComponent::DecreaseValue(const float Amount)
 
 void UBaseResourceComponent::IncreaseMaxValue(const float Amount, const bool bClampCurrentValue)
 {
+	AP_SCOPE_BUDGET(Resources, ResourceChange, this);
+
 	MaxValue += Amount;
 	OnMaxValueIncreased.Broadcast(Amount, MaxValue);
 
@@ -107,6 +135,8 @@ void UBaseResourceComponent::IncreaseMaxValue(const float Amount, const bool bCl
 
 void UBaseResourceComponent::DecreaseMaxValue(const float Amount, const bool bClampCurrentValue)
 {
+	AP_SCOPE_BUDGET(Resources, ResourceChange, this);
+
 	MaxValue -= Amount;
 	MaxValue = FMath::Max(MaxValue, 0.f);
 	OnMaxValueDecreased.Broadcast(Amount, MaxValue);
@@ -156,6 +186,7 @@ void UBaseResourceComponent::StartAutoChange()
 		return;
 	}
 
+	INC_DWORD_STAT(STAT_GameplayTimersSet);
 	TimerManager.SetTimer(ChangeTimerHandle, this, &UBaseResourceComponent::ChangeCurrentValue, ChangeDelayTime, true);
 }
 
@@ -195,6 +226,7 @@ void UBaseResourceComponent::StartDelayTimer()
 		return;
 	}
 
+	INC_DWORD_STAT(STAT_GameplayTimersSet);
 	TimerManager.SetTimer(
 						  ChangeStartDelayHandle,
 						  this,
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "BaseResourceComponent.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnValueIncreased, float, Amount, float, NewValue);
@@ -15,7 +16,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMaxValueIncreased, float, Amount
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMaxValueDecreased, float, Amount, float, NewValue);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
-class ACTIONPROTOTYPE_API UBaseResourceComponent : public UActorComponent
+class ACTIONPROTOTYPE_API UBaseResourceComponent : public UActorComponent, public ITickPolicy
 {
 	GENERATED_BODY()
 
@@ -27,12 +28,17 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	/** Auto change runs on timers, so the component ticks only for Blueprint Tick. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
+
 public:
 	// Called every frame
 	virtual void TickComponent(
 		float DeltaTime,
 		ELevelTick TickType,
 		FActorComponentTickFunction* ThisTickFunction) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
 
 	float GetCurrentValue() const;
 	float GetMaxValue() const;
@@ -42,6 +48,11 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="Resource Component")
 	void IncreaseValue(const float Amount, const bool bClampToMax = true);
+	/** Sets CurrentValue clamped between 0 and MaxValue without broadcasting delegates and resumes auto change if it's needed. */
+	UFUNCTION(BlueprintCallable, Category="Resource Component")
+	void SetCurrentValue(const float NewValue);
+	/** Sets MaxValue and CurrentValue without broadcasting delegates and resumes auto change if it's needed. */
+	void RestoreValues(const float NewMaxValue, const float NewCurrentValue);
 	/** Decreases CurrentValue on a given number. */
 	UFUNCTION(BlueprintCallable, Category="Resource Component")
 	void DecreaseValue(const float Amount);
@@ -3,10 +3,18 @@
 
 #include "BaseDoor.h"
 
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SaveGameSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SubLevelStreamingSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Door Transition"), STAT_DoorTransition, STATGROUP_ActionPrototype);
 
 ABaseDoor::ABaseDoor()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 void ABaseDoor::BeginPlay()
@@ -14,13 +22,61 @@ void ABaseDoor::BeginPlay()
 	CurrentState = InitialState;
 	SetTargetState(CurrentState);
 	Super::BeginPlay();
+	UTickPolicySubsystem::ApplyTickPolicy(this);
+
+	// The save baseline is taken before the streaming state is restored, so it matches the level defaults
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->RegisterActor(this);
+	}
+
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr)
+	{
+		SubLevelStreaming->RestorePersistentState(this);
+	}
+}
+
+void ABaseDoor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr && EndPlayReason == EEndPlayReason::RemovedFromWorld)
+	{
+		SubLevelStreaming->StorePersistentState(this);
+	}
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABaseDoor::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
 }
 
+void ABaseDoor::SerializePersistentState(FArchive& Archive)
+{
+	// A door in transition is stored in the state it's moving to
+	EDoorState State = CurrentState == EDoorState::Transition ? TargetState : CurrentState;
+	Archive << State;
+
+	if (Archive.IsLoading())
+	{
+		RestoreState(State);
+	}
+}
+
 bool ABaseDoor::OpenDoor()
 {
 	if (CurrentState == EDoorState::Locked || CurrentState == EDoorState::Disabled || CurrentState == EDoorState::Opened
@@ -133,6 +189,8 @@ void ABaseDoor::SetDoorLocation(
 	const FVector InitialLocation,
 	const FVector LocationOffset)
 {
+	AP_SCOPE_BUDGET(Interactables, DoorTransition, this);
+
 	if (DoorMesh == nullptr)
 	{
 		return;
@@ -148,6 +206,8 @@ void ABaseDoor::SetDoorRotation(
 	const FRotator InitialRotation,
 	const FRotator RotationOffset)
 {
+	AP_SCOPE_BUDGET(Interactables, DoorTransition, this);
+
 	if (DoorMesh == nullptr)
 	{
 		return;
@@ -176,6 +236,8 @@ void ABaseDoor::SetDoorLocationAndRotation(
 
 void ABaseDoor::ChangeStateTo(const EDoorState NewState)
 {
+	AP_SCOPE_BUDGET(Interactables, DoorTransition, this);
+
 	PreviousState = CurrentState;
 	CurrentState = NewState;
 
@@ -191,6 +253,7 @@ void ABaseDoor::ChangeStateTo(const EDoorState NewState)
 
 			if (CloseDelay > 0.f)
 			{
+				INC_DWORD_STAT(STAT_GameplayTimersSet);
 				GetWorld()->GetTimerManager().SetTimer(
 													   CloseDelayHandle,
 													   this,
@@ -218,6 +281,50 @@ void ABaseDoor::ChangeStateTo(const EDoorState NewState)
 	OnStateChanged();
 }
 
+void ABaseDoor::RestoreState(const EDoorState State)
+{
+	if (State == CurrentState || State == EDoorState::Transition)
+	{
+		return;
+	}
+
+	PreviousState = CurrentState;
+	CurrentState = State;
+	SetTargetState(CurrentState);
+
+	switch (CurrentState)
+	{
+		case EDoorState::Closed:
+			OnClosed();
+			break;
+		case EDoorState::Opened:
+			OnOpened();
+
+			if (CloseDelay > 0.f)
+			{
+				INC_DWORD_STAT(STAT_GameplayTimersSet);
+				GetWorld()->GetTimerManager().SetTimer(
+													   CloseDelayHandle,
+													   this,
+													   &ABaseDoor::StartTransition,
+													   CloseDelay,
+													   false
+													  );
+			}
+			break;
+		case EDoorState::Locked:
+			OnLocked();
+			break;
+		case EDoorState::Disabled:
+			OnDisabled();
+			break;
+		default:
+			break;
+	}
+
+	OnStateChanged();
+}
+
 void ABaseDoor::SetTargetState(const EDoorState State)
 {
 	if (State == EDoorState::Closed)
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ActionPrototype/Interfaces/PersistentState.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "GameFramework/Actor.h"
 #include "BaseDoor.generated.h"
 
@@ -29,13 +31,15 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDoorTransitionStarted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDoorTransitionReverted);
 
 UCLASS()
-class ACTIONPROTOTYPE_API ABaseDoor : public AActor
+class ACTIONPROTOTYPE_API ABaseDoor : public AActor, public IPersistentState, public ITickPolicy
 {
 	GENERATED_BODY()
 
 public:
 	ABaseDoor();
 	virtual void Tick(float DeltaTime) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
+	virtual void SerializePersistentState(FArchive& Archive) override;
 
 	/** Starts the door transition to the Opened state */
 	UFUNCTION(BlueprintCallable, Category="Door")
@@ -77,6 +81,11 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Doors move by timelines, so the tick is enabled only for Blueprint Tick. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
 
 	/** Calls when a door enters the Opened state */
 	UFUNCTION(BlueprintImplementableEvent, Category="Door")
@@ -163,6 +172,8 @@ private:
 	UFUNCTION()
 	void ChangeStateTo(const EDoorState NewState);
 	void SetTargetState(const EDoorState State);
+	/** Puts a door into the given state without broadcasting delegates, so linked actors aren't triggered again. */
+	void RestoreState(const EDoorState State);
 
 	/** Determines a door's transition duration */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Door", meta=(AllowPrivateAccess="true"))
@@ -4,14 +4,21 @@
 #include "FloatingPlatform.h"
 
 
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SaveGameSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SubLevelStreamingSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
 #include "Components/SplineComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Platform Movement"), STAT_PlatformMovement, STATGROUP_ActionPrototype);
 
 // Sets default values
 AFloatingPlatform::AFloatingPlatform()
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 // Called when the game starts or when spawned
@@ -34,14 +41,82 @@ void AFloatingPlatform::BeginPlay()
 	}
 	
 	Super::BeginPlay();
+	UTickPolicySubsystem::ApplyTickPolicy(this);
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->RegisterActor(this);
+	}
+
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr)
+	{
+		SubLevelStreaming->RestorePersistentState(this);
+	}
+}
+
+void AFloatingPlatform::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr && EndPlayReason == EEndPlayReason::RemovedFromWorld)
+	{
+		SubLevelStreaming->StorePersistentState(this);
+	}
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
 void AFloatingPlatform::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
 }
 
+void AFloatingPlatform::SerializePersistentState(FArchive& Archive)
+{
+	EFloatingPlatformState State = CurrentState;
+	int32 PreviousPoint = PreviousPointIndex;
+	int32 NextPoint = NextPointIndex;
+	bool bWasReversed = bIsReversed;
+	Archive << State;
+	Archive << PreviousPoint;
+	Archive << NextPoint;
+	Archive << bWasReversed;
+
+	if (!Archive.IsLoading() || IsPointIndexOutOfBounds(PreviousPoint) || IsPointIndexOutOfBounds(NextPoint))
+	{
+		return;
+	}
+
+	GetWorld()->GetTimerManager().ClearTimer(WaitTimerHandle);
+	PreviousPointIndex = PreviousPoint;
+	NextPointIndex = NextPoint;
+	bIsReversed = bWasReversed;
+	MoveAndRotateAlongSpline(0.f);
+
+	if (State == EFloatingPlatformState::Idle)
+	{
+		CurrentState = EFloatingPlatformState::Idle;
+		return;
+	}
+
+	CalculateTravelTime();
+	CurrentState = EFloatingPlatformState::Move;
+	StartMovement();
+}
+
 void AFloatingPlatform::SetTargetSpline(const AActor* TargetActor)
 {
 	if (TargetActor == nullptr)
@@ -65,6 +140,17 @@ void AFloatingPlatform::SetTargetSpline(const AActor* TargetActor)
 	}
 }
 
+void AFloatingPlatform::SetActorWithSpline(AActor* NewActorWithSpline)
+{
+	ActorWithSpline = NewActorWithSpline;
+}
+
+void AFloatingPlatform::SetMovementMode(const EFloatingPlatformMode NewMode, const bool bStartOnBeginPlay)
+{
+	MovementMode = NewMode;
+	bAutoStart = bStartOnBeginPlay;
+}
+
 void AFloatingPlatform::StartMovement()
 {
 	if (MovementMode == EFloatingPlatformMode::Manual && CurrentState != EFloatingPlatformState::Move)
@@ -179,12 +265,16 @@ void AFloatingPlatform::SetRotationAlongSpline(const float PathProgress)
 
 void AFloatingPlatform::MoveAndRotateAlongSpline(const float PathProgress)
 {
+	AP_SCOPE_BUDGET(Interactables, PlatformMovement, this);
+
 	SetLocationAlongSpline(PathProgress);
 	SetRotationAlongSpline(PathProgress);
 }
 
 void AFloatingPlatform::ContinueMovementAlongSpline()
 {
+	AP_SCOPE_BUDGET(Interactables, PlatformMovement, this);
+
 	if (CurrentState == EFloatingPlatformState::Idle)
 	{
 		return;
@@ -219,6 +309,7 @@ void AFloatingPlatform::StartWaitTimer()
 		CurrentState = EFloatingPlatformState::Wait;
 		OnWaitStarted();
 		OnPlatformWaitStarted.Broadcast();
+		INC_DWORD_STAT(STAT_GameplayTimersSet);
 		TimerManager.SetTimer(WaitTimerHandle, this, &AFloatingPlatform::FinishWaitTimer, WaitDuration, false);
 	}
 }
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ActionPrototype/Interfaces/PersistentState.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "GameFramework/Actor.h"
 #include "FloatingPlatform.generated.h"
 
@@ -35,7 +37,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlatformWaitStarted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlatformWaitFinished);
 
 UCLASS()
-class ACTIONPROTOTYPE_API AFloatingPlatform : public AActor
+class ACTIONPROTOTYPE_API AFloatingPlatform : public AActor, public IPersistentState, public ITickPolicy
 {
 	GENERATED_BODY()
 
@@ -44,12 +46,24 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Determines when the platform ticks, a Blueprint Tick enables it. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
 
 public:
 	virtual void Tick(float DeltaTime) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
+	/** Stores the path points and the movement state. A moving platform is restored at the point it left. */
+	virtual void SerializePersistentState(FArchive& Archive) override;
 
 	/** Sets TargetSpline value if the given actor has USplineComponent */
 	void SetTargetSpline(const AActor* TargetActor);
+	/** Sets the actor whose spline is followed after BeginPlay. Used when a level is assembled from code. */
+	void SetActorWithSpline(AActor* NewActorWithSpline);
+	/** Sets the movement mode and whether the platform starts moving on BeginPlay. */
+	void SetMovementMode(const EFloatingPlatformMode NewMode, const bool bStartOnBeginPlay);
 
 	/** Starts platform movement.
 	  * @warning it doesn't work if MovementMode is Manual.
@@ -2,12 +2,21 @@
 
 
 #include "FloorSwitch.h"
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Actors/Gameplay/BaseDoor.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SaveGameSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SubLevelStreamingSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Floor Switch Transition"), STAT_FloorSwitchTransition, STATGROUP_ActionPrototype);
+
 AFloorSwitch::AFloorSwitch()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	TriggerVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("Trigger Volume"));
 	RootComponent = TriggerVolume;
@@ -33,13 +42,65 @@ void AFloorSwitch::BeginPlay()
 	InitialMeshLocation = SwitchMesh->GetComponentLocation();
 	InitialMeshRotation = SwitchMesh->GetComponentRotation();
 	Super::BeginPlay();
+
+	if (CurrentState != EFloorSwitchState::Disabled)
+	{
+		UTickPolicySubsystem::ApplyTickPolicy(this);
+	}
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->RegisterActor(this);
+	}
+
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr)
+	{
+		SubLevelStreaming->RestorePersistentState(this);
+	}
+}
+
+void AFloorSwitch::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr && EndPlayReason == EEndPlayReason::RemovedFromWorld)
+	{
+		SubLevelStreaming->StorePersistentState(this);
+	}
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFloorSwitch::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
 }
 
+void AFloorSwitch::SerializePersistentState(FArchive& Archive)
+{
+	// A switch in transition is stored in the state it's moving to
+	EFloorSwitchState State = CurrentState == EFloorSwitchState::Transition ? TargetState : CurrentState;
+	Archive << State;
+	Archive << PressesNumber;
+
+	if (Archive.IsLoading())
+	{
+		RestoreState(State);
+	}
+}
+
 void AFloorSwitch::LockFloorSwitch()
 {
 	if (CurrentState == EFloorSwitchState::Locked || CurrentState == EFloorSwitchState::Transition)
@@ -94,7 +155,7 @@ void AFloorSwitch::EnableFloorSwitch()
 	TriggerVolume->SetGenerateOverlapEvents(true);
 	TriggerVolume->SetCollisionResponseToChannels(ECR_Ignore);
 	TriggerVolume->SetCollisionResponseToChannel(ECC_GameTraceChannel1, ECR_Overlap);
-	SetActorTickEnabled(true);
+	UTickPolicySubsystem::ApplyTickPolicy(this);
 	CurrentState = EFloorSwitchState::Idle;
 	OnEnabled();
 }
@@ -117,8 +178,20 @@ float AFloorSwitch::SetTransitionTime(const float NewTime)
 	return TransitionTime = FMath::Abs(NewTime);
 }
 
+void AFloorSwitch::AddLinkedDoor(ABaseDoor* Door)
+{
+	if (Door == nullptr)
+	{
+		return;
+	}
+
+	LinkedDoors.AddUnique(Door);
+}
+
 void AFloorSwitch::SetMeshLocation(const FVector LocationOffset) const
 {
+	AP_SCOPE_BUDGET(Interactables, FloorSwitchTransition, this);
+
 	FVector NewLocation = InitialMeshLocation;
 	NewLocation += LocationOffset;	
 	SwitchMesh->SetWorldLocation(NewLocation);
@@ -126,6 +199,8 @@ void AFloorSwitch::SetMeshLocation(const FVector LocationOffset) const
 
 void AFloorSwitch::SetMeshRotation(const FRotator RotationOffset) const
 {
+	AP_SCOPE_BUDGET(Interactables, FloorSwitchTransition, this);
+
 	FRotator NewRotation = InitialMeshRotation;
 	NewRotation += RotationOffset;
 	SwitchMesh->SetWorldRotation(NewRotation);
@@ -162,6 +237,7 @@ void AFloorSwitch::TriggerOverlapBegin(
 	{
 		if (PressDelay > 0.f)
 		{
+			INC_DWORD_STAT(STAT_GameplayTimersSet);
 			GetWorld()->GetTimerManager().SetTimer(
 												   PressDelayHandle,
 												   this,
@@ -223,6 +299,8 @@ void AFloorSwitch::TriggerOverlapEnd(
 
 void AFloorSwitch::ChangeStateTo(const EFloorSwitchState NewState)
 {
+	AP_SCOPE_BUDGET(Interactables, FloorSwitchTransition, this);
+
 	PreviousState = CurrentState;
 	CurrentState = NewState;
 	OnStateChanged();
@@ -232,11 +310,27 @@ void AFloorSwitch::ChangeStateTo(const EFloorSwitchState NewState)
 		case EFloorSwitchState::Idle:
 			OnIdle();
 			OnFloorSwitchIdle.Broadcast();
+
+			for (ABaseDoor* Door : LinkedDoors)
+			{
+				if (Door != nullptr)
+				{
+					Door->CloseDoor();
+				}
+			}
 			break;
 		case EFloorSwitchState::Pressed:
 			OnPressed();
 			OnFloorSwitchPressed.Broadcast();
 
+			for (ABaseDoor* Door : LinkedDoors)
+			{
+				if (Door != nullptr)
+				{
+					Door->OpenDoor();
+				}
+			}
+
 			if (bLimitedPresses)
 			{
 				DecreasePressesNumber(1);
@@ -278,6 +372,50 @@ void AFloorSwitch::ChangeStateTo(const EFloorSwitchState NewState)
 	}
 }
 
+void AFloorSwitch::RestoreState(const EFloorSwitchState State)
+{
+	if (State == CurrentState || State == EFloorSwitchState::Transition)
+	{
+		return;
+	}
+
+	if (State == EFloorSwitchState::Disabled)
+	{
+		DisableFloorSwitch();
+		return;
+	}
+
+	PreviousState = CurrentState;
+	CurrentState = State;
+	SetTargetState(CurrentState);
+	OnStateChanged();
+
+	switch (CurrentState)
+	{
+		case EFloorSwitchState::Idle:
+			OnIdle();
+			break;
+		case EFloorSwitchState::Pressed:
+			OnPressed();
+
+			// Nothing is in the trigger of a freshly loaded switch
+			if (PressedDuration > 0.f)
+			{
+				SetPressedTimer();
+			}
+			else
+			{
+				StartTransition();
+			}
+			break;
+		case EFloorSwitchState::Locked:
+			OnLocked();
+			break;
+		default:
+			break;
+	}
+}
+
 void AFloorSwitch::SetTargetState(const EFloorSwitchState State)
 {
 	if (State == EFloorSwitchState::Idle)
@@ -305,6 +443,7 @@ void AFloorSwitch::RevertTransition()
 
 void AFloorSwitch::SetPressedTimer()
 {
+	INC_DWORD_STAT(STAT_GameplayTimersSet);
 	GetWorld()->GetTimerManager().SetTimer(
 										   PressedDurationHandle,
 										   this,
@@ -5,9 +5,12 @@
 #include "CoreMinimal.h"
 
 #include "FunctionalTestingManager.h"
+#include "ActionPrototype/Interfaces/PersistentState.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "GameFramework/Actor.h"
 #include "FloorSwitch.generated.h"
 
+class ABaseDoor;
 class UBoxComponent;
 class UStaticMeshComponent;
 
@@ -37,13 +40,15 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSwitchTransitionStarted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSwitchTransitionReverted);
 
 UCLASS()
-class ACTIONPROTOTYPE_API AFloorSwitch : public AActor
+class ACTIONPROTOTYPE_API AFloorSwitch : public AActor, public IPersistentState, public ITickPolicy
 {
 	GENERATED_BODY()
 
 public:
 	AFloorSwitch();
 	virtual void Tick(float DeltaTime) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
+	virtual void SerializePersistentState(FArchive& Archive) override;
 
 	/* Called when a switch changes its state to Idle */
 	UPROPERTY(BlueprintAssignable, Category="Floor Switch|Delegates")
@@ -85,8 +90,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Floor Switch")
 	float SetTransitionTime(const float NewTime);
 
+	/* Adds a door opened on press and closed when the switch becomes Idle again. */
+	UFUNCTION(BlueprintCallable, Category="Floor Switch")
+	void AddLinkedDoor(ABaseDoor* Door);
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Determines when the switch ticks, a disabled switch never ticks. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
 
 	// FUNCTIONS
 	UFUNCTION()
@@ -175,6 +189,8 @@ private:
 	UFUNCTION()
 	void ChangeStateTo(const EFloorSwitchState NewState);
 	void SetTargetState(const EFloorSwitchState State);
+	/* Puts a switch into the given state without broadcasting delegates and spending presses. */
+	void RestoreState(const EFloorSwitchState State);
 	
 	/* Determines time of transition between Active and Pressed states. */
 	UPROPERTY(
@@ -188,6 +204,10 @@ private:
 	FVector TransitionLocationOffset{FVector::ZeroVector};
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Floor Switch", meta=(AllowPrivateAccess = "true"))
 	FRotator TransitionRotationOffset{FRotator::ZeroRotator};
+	/* Doors opened when the switch is pressed and closed when it becomes Idle again. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Floor Switch", meta=(AllowPrivateAccess="true"))
+	TArray<ABaseDoor*> LinkedDoors{};
+
 	/* Determines if Transition can be reverted */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Floor Switch", meta=(AllowPrivateAccess="true"))
 	bool bIsTransitionRevertible{false};
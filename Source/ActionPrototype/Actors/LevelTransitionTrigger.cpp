@@ -3,28 +3,116 @@
 
 #include "LevelTransitionTrigger.h"
 
+#include "ActionPrototype/ActionPrototype.h"
 #include "ActionPrototype/Characters/PlayerCharacter.h"
-#include "Kismet/GameplayStatics.h"
+#include "ActionPrototype/Core/Subsystems/LevelTransitionSubsystem.h"
+#include "Components/SphereComponent.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+ALevelTransitionTrigger::ALevelTransitionTrigger(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+    PreloadVolume = CreateDefaultSubobject<USphereComponent>(TEXT("Preload Volume"));
+    PreloadVolume->SetupAttachment(RootComponent);
+    PreloadVolume->SetSphereRadius(PreloadRadius);
+    PreloadVolume->SetCollisionProfileName(TEXT("Trigger"));
+    PreloadVolume->SetCanEverAffectNavigation(false);
+}
 
 void ALevelTransitionTrigger::BeginPlay()
 {
+    Super::BeginPlay();
+    PreloadVolume->SetSphereRadius(PreloadRadius);
     OnActorBeginOverlap.AddDynamic(this, &ALevelTransitionTrigger::LoadLevel);
+    PreloadVolume->OnComponentBeginOverlap.AddDynamic(this, &ALevelTransitionTrigger::OnPreloadVolumeBeginOverlap);
+}
+
+void ALevelTransitionTrigger::PostLoad()
+{
+    Super::PostLoad();
+
+    if (!TargetLevel.IsNull() || TargetLevelName_DEPRECATED.IsNone())
+    {
+        return;
+    }
+
+    FString PackageName = TargetLevelName_DEPRECATED.ToString();
+
+#if WITH_EDITOR
+    // Short names are searched on disk only in the editor, the converted trigger is saved with the level
+    if (FPackageName::IsShortPackageName(PackageName))
+    {
+        FPackageName::SearchForPackageOnDisk(PackageName + FPackageName::GetMapPackageExtension(), &PackageName);
+    }
+#endif
+
+    if (!FPackageName::IsValidLongPackageName(PackageName))
+    {
+        UE_LOG(LogActionPrototype, Warning, TEXT("%s: target level %s isn't found, set TargetLevel instead."), *GetName(), *PackageName);
+        return;
+    }
+
+    TargetLevel = TSoftObjectPtr<UWorld>{FSoftObjectPath{PackageName + TEXT(".") + FPackageName::GetShortName(PackageName)}};
+    TargetLevelName_DEPRECATED = NAME_None;
+}
+
+float ALevelTransitionTrigger::GetLoadProgress() const
+{
+    const ULevelTransitionSubsystem* LevelTransition = ULevelTransitionSubsystem::Get(this);
+    return LevelTransition != nullptr ? LevelTransition->GetLoadProgress(GetTargetPackageName()) : 0.f;
 }
 
 void ALevelTransitionTrigger::LoadLevel(AActor* OverlappedActor, AActor* OtherActor)
 {
-    const UWorld* World = GetWorld();
-    
-    if (OtherActor == nullptr || World == nullptr)
+    if (Cast<APlayerCharacter>(OtherActor) == nullptr || !IsTargetLevelValid())
+    {
+        return;
+    }
+
+    ULevelTransitionSubsystem* LevelTransition = ULevelTransitionSubsystem::Get(this);
+
+    if (LevelTransition != nullptr)
+    {
+        LevelTransition->TransitionToLevel(GetTargetPackageName());
+    }
+}
+
+void ALevelTransitionTrigger::OnPreloadVolumeBeginOverlap(
+    UPrimitiveComponent* OverlappedComponent,
+    AActor* OtherActor,
+    UPrimitiveComponent* OtherComp,
+    int32 OtherBodyIndex,
+    bool bFromSweep,
+    const FHitResult& SweepResult)
+{
+    if (Cast<APlayerCharacter>(OtherActor) == nullptr || !IsTargetLevelValid())
     {
         return;
     }
 
-    const FName CurrentLevelName = FName(*World->GetMapName());
+    ULevelTransitionSubsystem* LevelTransition = ULevelTransitionSubsystem::Get(this);
 
-    if (CurrentLevelName != TargetLevelName)
+    if (LevelTransition != nullptr)
     {
-        UGameplayStatics::OpenLevel(World, TargetLevelName);
+        LevelTransition->PreloadLevel(GetTargetPackageName());
     }
 }
 
+bool ALevelTransitionTrigger::IsTargetLevelValid() const
+{
+    const UWorld* World = GetWorld();
+    const FName TargetPackageName = GetTargetPackageName();
+
+    if (World == nullptr || TargetPackageName.IsNone())
+    {
+        return false;
+    }
+
+    const FName CurrentPackageName = FName(*UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()));
+    return CurrentPackageName != TargetPackageName;
+}
+
+FName ALevelTransitionTrigger::GetTargetPackageName() const
+{
+    return TargetLevel.IsNull() ? NAME_None : FName(*TargetLevel.GetLongPackageName());
+}
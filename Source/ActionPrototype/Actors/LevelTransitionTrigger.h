@@ -6,8 +6,11 @@
 #include "Engine/TriggerBox.h"
 #include "LevelTransitionTrigger.generated.h"
 
+class USphereComponent;
+
 /**
- * 
+ * Starts loading the target level in the background when the player gets into the preload radius
+ * and opens it when the player enters the trigger box.
  */
 UCLASS()
 class ACTIONPROTOTYPE_API ALevelTransitionTrigger : public ATriggerBox
@@ -15,13 +18,42 @@ class ACTIONPROTOTYPE_API ALevelTransitionTrigger : public ATriggerBox
 	GENERATED_BODY()
 
 public:
+	ALevelTransitionTrigger(const FObjectInitializer& ObjectInitializer);
+
+	/** Level opened when the player enters the trigger. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Level Data")
-	FName TargetLevelName{"Level Name"};
+	TSoftObjectPtr<UWorld> TargetLevel{};
+
+	/** Returns the load progress of the target level in range [0, 1]. */
+	UFUNCTION(BlueprintPure, Category="Level Data")
+	float GetLoadProgress() const;
+
+	virtual void PostLoad() override;
 
 protected:
 	virtual void BeginPlay() override;
 
 private:
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
+	USphereComponent* PreloadVolume{nullptr};
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Level Data", meta=(AllowPrivateAccess="true", ClampMin="0.0"))
+	float PreloadRadius{3000.f};
+	/** Short or long name of the target level saved before TargetLevel, converted on load. */
+	UPROPERTY()
+	FName TargetLevelName_DEPRECATED{NAME_None};
+
 	UFUNCTION()
 	void LoadLevel(AActor* OverlappedActor, AActor* OtherActor);
+	UFUNCTION()
+	void OnPreloadVolumeBeginOverlap(
+		UPrimitiveComponent* OverlappedComponent,
+		AActor* OtherActor,
+		UPrimitiveComponent* OtherComp,
+		int32 OtherBodyIndex,
+		bool bFromSweep,
+		const FHitResult& SweepResult);
+
+	bool IsTargetLevelValid() const;
+	/** Returns the long package name of the target level, none if it isn't set. */
+	FName GetTargetPackageName() const;
 };
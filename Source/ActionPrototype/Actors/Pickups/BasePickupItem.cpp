@@ -3,11 +3,20 @@
 
 #include "BasePickupItem.h"
 
+#include "ActionPrototype/ActionPrototype.h"
 #include "ActionPrototype/Characters/PlayerCharacter.h"
+#include "ActionPrototype/Core/Subsystems/AssetStreamingSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/EffectPoolSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/PickupPoolSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/PickupSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SaveGameSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Components/TimelineComponent.h"
-#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Process"), STAT_PickupProcess, STATGROUP_ActionPrototype);
 
 
 // Sets default values
@@ -15,10 +24,14 @@ ABasePickupItem::ABasePickupItem()
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	TriggerVolume = CreateDefaultSubobject<USphereComponent>(TEXT("Pickup Collision"));
 	RootComponent = TriggerVolume;
 	TriggerVolume->SetCanEverAffectNavigation(false);
+	// Pickups are collected through UPickupSubsystem queries, the sphere only defines the pickup radius
+	TriggerVolume->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	TriggerVolume->SetGenerateOverlapEvents(false);
 
 	PickupMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Pickup Mesh"));
 	PickupMesh->SetupAttachment(RootComponent);
@@ -35,7 +48,9 @@ ABasePickupItem::ABasePickupItem()
 // Called when the game starts or when spawned
 void ABasePickupItem::BeginPlay()
 {
+	PlacedTransform = GetActorTransform();
 	MeshInitialLocation = PickupMesh->GetComponentLocation();
+	MeshInitialRelativeLocation = PickupMesh->GetRelativeLocation();
 
 	if (LocationAnimationCurve != nullptr)
 	{
@@ -46,30 +61,134 @@ void ABasePickupItem::BeginPlay()
 		PickupAnimationTimeline->Play();
 	}
 
+	UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+
+	if (PickupSubsystem != nullptr)
+	{
+		PickupSubsystem->RegisterPickup(this);
+	}
+
+	UAssetStreamingSubsystem* AssetStreaming = UAssetStreamingSubsystem::Get(this);
+
+	if (AssetStreaming != nullptr)
+	{
+		GetStreamedAssets(StreamedAssets);
+
+		for (const FSoftObjectPath& AssetPath : StreamedAssets)
+		{
+			AssetStreaming->RequestAsset(AssetPath);
+		}
+	}
+
 	Super::BeginPlay();
+
+	if (bIsPickupActive)
+	{
+		UTickPolicySubsystem::ApplyTickPolicy(this);
+	}
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->RegisterActor(this);
+	}
+}
+
+void ABasePickupItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+
+	if (PickupSubsystem != nullptr)
+	{
+		PickupSubsystem->UnregisterPickup(this);
+	}
+
+	UAssetStreamingSubsystem* AssetStreaming = UAssetStreamingSubsystem::Get(this);
+
+	if (AssetStreaming != nullptr)
+	{
+		for (const FSoftObjectPath& AssetPath : StreamedAssets)
+		{
+			AssetStreaming->ReleaseAsset(AssetPath);
+		}
+	}
+
+	StreamedAssets.Empty();
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
 void ABasePickupItem::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
 }
 
-void ABasePickupItem::ProcessPickup( APlayerCharacter* PlayerCharacter)
+void ABasePickupItem::SerializePersistentState(FArchive& Archive)
 {
-	if (PickupMainParticles != nullptr)
+	bool bIsCollectedState = bIsCollected;
+	Archive << bIsCollectedState;
+
+	if (!Archive.IsLoading() || bIsCollectedState == bIsCollected)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(this, PickupMainParticles, MeshInitialLocation);
+		return;
 	}
 
-	if (PickupSound != nullptr)
+	bIsCollected = bIsCollectedState;
+	UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>();
+
+	if (bIsCollected)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, PickupSound, MeshInitialLocation);
+		if (PickupPool != nullptr)
+		{
+			PickupPool->ReleasePickup(this);
+		}
+		else
+		{
+			Destroy();
+		}
 	}
+	else if (PickupPool == nullptr || !PickupPool->ClaimPickup(this, PlacedTransform))
+	{
+		// Level pickups aren't pooled, so they're activated in place
+		ActivatePickup(PlacedTransform);
+	}
+}
+
+void ABasePickupItem::ProcessPickup( APlayerCharacter* PlayerCharacter)
+{
+	AP_SCOPE_BUDGET(Interactables, PickupProcess, this);
+
+	UEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UEffectPoolSubsystem>();
 
+	if (EffectPool != nullptr)
+	{
+		// Effects still streaming in are skipped rather than loaded synchronously
+		EffectPool->PlayEffectsAtLocation(PickupMainParticles.Get(), PickupSound.Get(), MeshInitialLocation);
+	}
+
+	bIsCollected = true;
 	ActivatePickupEffect(PlayerCharacter);
 	OnPickup();
-	Destroy();
+
+	UPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UPickupPoolSubsystem>();
+
+	if (PickupPool != nullptr)
+	{
+		PickupPool->ReleasePickup(this);
+	}
+	else
+	{
+		Destroy();
+	}
 }
 
 void ABasePickupItem::SetAnimationSpeed(const float NewAnimationSpeed)
@@ -78,10 +197,94 @@ void ABasePickupItem::SetAnimationSpeed(const float NewAnimationSpeed)
 	PickupAnimationTimeline->SetPlayRate(AnimationSpeed);
 }
 
+float ABasePickupItem::GetPickupRadius() const
+{
+	return TriggerVolume->GetScaledSphereRadius();
+}
+
+void ABasePickupItem::MoveTowards(const FVector& TargetLocation, const float Distance)
+{
+	const FVector CurrentLocation = GetActorLocation();
+	const FVector NewLocation = FMath::VInterpConstantTo(CurrentLocation, TargetLocation, 1.f, Distance);
+	MeshInitialLocation += NewLocation - CurrentLocation;
+	SetActorLocation(NewLocation);
+
+	UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+
+	if (PickupSubsystem != nullptr)
+	{
+		PickupSubsystem->UpdatePickupLocation(this);
+	}
+}
+
+void ABasePickupItem::DeactivatePickup()
+{
+	if (!bIsPickupActive)
+	{
+		return;
+	}
+
+	bIsPickupActive = false;
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	PickupAnimationTimeline->Stop();
+	PickupIdleParticles->DeactivateSystem();
+
+	UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+
+	if (PickupSubsystem != nullptr)
+	{
+		PickupSubsystem->UnregisterPickup(this);
+	}
+}
+
+void ABasePickupItem::ActivatePickup(const FTransform& Transform)
+{
+	if (bIsPickupActive)
+	{
+		return;
+	}
+
+	bIsPickupActive = true;
+	SetActorTransform(Transform);
+	MeshInitialLocation = Transform.TransformPosition(MeshInitialRelativeLocation);
+	PickupMesh->SetWorldLocation(MeshInitialLocation);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	UTickPolicySubsystem::ApplyTickPolicy(this);
+	PickupIdleParticles->ActivateSystem(true);
+
+	if (LocationAnimationCurve != nullptr)
+	{
+		PickupAnimationTimeline->PlayFromStart();
+	}
+
+	UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+
+	if (PickupSubsystem != nullptr)
+	{
+		PickupSubsystem->RegisterPickup(this);
+	}
+}
+
 void ABasePickupItem::ActivatePickupEffect(APlayerCharacter* PlayerCharacter)
 {
 }
 
+void ABasePickupItem::GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	if (!PickupMainParticles.IsNull())
+	{
+		OutAssets.AddUnique(PickupMainParticles.ToSoftObjectPath());
+	}
+
+	if (!PickupSound.IsNull())
+	{
+		OutAssets.AddUnique(PickupSound.ToSoftObjectPath());
+	}
+}
+
 void ABasePickupItem::AnimateMeshLocation(const float AnimationProgress) const
 {
 	const FVector NewLocation = MeshInitialLocation + MeshLocationOffset * AnimationProgress;
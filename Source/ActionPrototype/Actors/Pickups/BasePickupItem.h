@@ -5,7 +5,9 @@
 #include "CoreMinimal.h"
 
 
+#include "ActionPrototype/Interfaces/PersistentState.h"
 #include "ActionPrototype/Interfaces/ReactToInteraction.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "GameFramework/Actor.h"
 #include "BasePickupItem.generated.h"
 
@@ -17,7 +19,7 @@ class UParticleSystem;
 class APlayerCharacter;
 
 UCLASS()
-class ACTIONPROTOTYPE_API ABasePickupItem : public AActor
+class ACTIONPROTOTYPE_API ABasePickupItem : public AActor, public IPersistentState, public ITickPolicy
 {
 	GENERATED_BODY()
 
@@ -28,18 +30,26 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Determines when the pickup ticks, a pooled pickup never ticks. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
 
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
+	/** Stores if a pickup placed in the level is collected. */
+	virtual void SerializePersistentState(FArchive& Archive) override;
 
 	UFUNCTION(BlueprintCallable, Category="Pickup")
 	void ProcessPickup(APlayerCharacter* PlayerCharacter);
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Pickup|Effects")
-	UParticleSystem* PickupMainParticles{nullptr};
+	TSoftObjectPtr<UParticleSystem> PickupMainParticles{};
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Pickup|Effects")
-	USoundBase* PickupSound{nullptr};
+	TSoftObjectPtr<USoundBase> PickupSound{};
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Pickup|Animation")
 	UCurveFloat* LocationAnimationCurve{nullptr};
@@ -51,10 +61,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Pickup|Animation")
 	void SetAnimationSpeed(const float NewAnimationSpeed);
 
+	/** Determines if a pickup is pulled by the player's magnet radius. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Pickup")
+	bool bIsMagnetic{false};
+	/** Returns the radius in which the player collects a pickup. */
+	UFUNCTION(BlueprintPure, Category="Pickup")
+	float GetPickupRadius() const;
+	/** Moves a pickup towards the given location not further than the given distance. */
+	void MoveTowards(const FVector& TargetLocation, const float Distance);
+	/** Hides a pickup, disables its collision, animation and particles and removes it from UPickupSubsystem. */
+	void DeactivatePickup();
+	/** Moves a deactivated pickup to the given transform and restores its collision, animation and particles. */
+	void ActivatePickup(const FTransform& Transform);
+	UFUNCTION(BlueprintPure, Category="Pickup")
+	FORCEINLINE bool IsPickupActive() const { return bIsPickupActive; }
+
 protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Pickup")
 	void OnPickup();
 	virtual void ActivatePickupEffect(APlayerCharacter* PlayerCharacter);
+	/** Collects soft referenced assets kept resident by UAssetStreamingSubsystem while the pickup is in play. */
+	virtual void GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const;
 
 private:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
@@ -71,6 +98,16 @@ private:
 
 	UPROPERTY(BlueprintReadOnly, Category="Pickup|Mesh", meta=(AllowPrivateAccess="true"))
 	FVector MeshInitialLocation{FVector::ZeroVector};
+	UPROPERTY(BlueprintReadOnly, Category="Pickup|Mesh", meta=(AllowPrivateAccess="true"))
+	FVector MeshInitialRelativeLocation{FVector::ZeroVector};
+	UPROPERTY(BlueprintReadOnly, Category="Pickup", meta=(AllowPrivateAccess="true"))
+	bool bIsPickupActive{true};
+	/** Saved instead of bIsPickupActive, which pooling changes when a pickup is handed out again. */
+	bool bIsCollected{false};
+	/** Transform of a pickup on begin play, a restored pickup is activated with it. */
+	FTransform PlacedTransform{};
+
+	TArray<FSoftObjectPath> StreamedAssets{};
 
 	void AnimateMeshLocation(const float AnimationProgress) const;
 	void AnimateMeshRotation() const;
@@ -11,7 +11,17 @@ void APickupWeapon::ActivatePickupEffect(APlayerCharacter* PlayerCharacter)
 		return;
 	}
 
-	PlayerCharacter->EquipWeapon(WeaponClass, WeaponSlot);
+	PlayerCharacter->EquipWeaponAsync(WeaponClass, WeaponSlot);
+}
+
+void APickupWeapon::GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	Super::GetStreamedAssets(OutAssets);
+
+	if (!WeaponClass.IsNull())
+	{
+		OutAssets.AddUnique(WeaponClass.ToSoftObjectPath());
+	}
 }
 
 
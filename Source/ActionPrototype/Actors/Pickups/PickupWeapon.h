@@ -20,8 +20,9 @@ public:
 	EWeaponSlot WeaponSlot{EWeaponSlot::Right};
 protected:
 	virtual void ActivatePickupEffect(APlayerCharacter* PlayerCharacter) override;
+	virtual void GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const override;
 
 private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon pickup", meta=(AllowPrivateAccess="true"))
-	TSubclassOf<AWeapon> WeaponClass{nullptr};
+	TSoftClassPtr<AWeapon> WeaponClass{};
 };
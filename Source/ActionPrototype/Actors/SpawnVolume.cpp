@@ -4,15 +4,22 @@
 #include "SpawnVolume.h"
 
 #include "Components/BoxComponent.h"
-#include "Kismet/KismetMathLibrary.h"
 #include "Engine/World.h"
 #include "Math/TransformCalculus3D.h"
 #include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "ActionPrototype/Core/Subsystems/EnemyCrowdSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/GameplayMemorySubsystem.h"
+#include "ActionPrototype/Core/Subsystems/RandomSeedSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Spawn"), STAT_EnemySpawn, STATGROUP_ActionPrototype);
 
 // Sets default values
 ASpawnVolume::ASpawnVolume()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	SpawnVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("Spawn Volume"));
 	RootComponent = SpawnVolume;
 }
@@ -21,12 +28,19 @@ ASpawnVolume::ASpawnVolume()
 void ASpawnVolume::BeginPlay()
 {
 	Super::BeginPlay();
-	
+	UTickPolicySubsystem::ApplyTickPolicy(this);
+	RandomStream = URandomSeedSubsystem::MakeStreamFor(this);
+
+	if (CrowdEnemiesNumber > 0)
+	{
+		ProcessCrowdSpawn(CrowdEnemyClass, CrowdEnemiesNumber);
+	}
 }
 
 // Called every frame
 void ASpawnVolume::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
 }
 
@@ -34,12 +48,19 @@ FVector ASpawnVolume::GetRandomPoint() const
 {
 	const FVector VolumeExtent = SpawnVolume->GetScaledBoxExtent();
 	const FVector VolumeOrigin = SpawnVolume->GetComponentLocation();
-	const FVector Point = UKismetMathLibrary::RandomPointInBoundingBox(VolumeOrigin, VolumeExtent);
-	return Point;
+	const FVector Point{
+		RandomStream.FRandRange(-VolumeExtent.X, VolumeExtent.X),
+		RandomStream.FRandRange(-VolumeExtent.Y, VolumeExtent.Y),
+		RandomStream.FRandRange(-VolumeExtent.Z, VolumeExtent.Z)
+	};
+	return VolumeOrigin + Point;
 }
 
 AEnemyCharacter* ASpawnVolume::ProcessEnemySpawn(const TSubclassOf<AEnemyCharacter> EnemyClass, const FVector& SpawnLocation)
 {
+	AP_SCOPE_BUDGET(Spawning, EnemySpawn, this);
+	AP_LLM_SCOPE(Enemies);
+
 	if (EnemyClass == nullptr)
 	{
 		return {nullptr};
@@ -58,3 +79,45 @@ AEnemyCharacter* ASpawnVolume::ProcessEnemySpawn(const TSubclassOf<AEnemyCharact
 	return EnemyInstance;
 }
 
+int32 ASpawnVolume::SpawnEnemies(const TSubclassOf<AEnemyCharacter> EnemyClass, const int32 EnemiesNumber)
+{
+	int32 SpawnedNumber{0};
+
+	for (int32 Index = 0; Index < EnemiesNumber; ++Index)
+	{
+		if (ProcessEnemySpawn(EnemyClass, GetRandomPoint()) != nullptr)
+		{
+			++SpawnedNumber;
+		}
+	}
+
+	UGameplayMemorySubsystem* GameplayMemory = GetWorld()->GetSubsystem<UGameplayMemorySubsystem>();
+
+	if (GameplayMemory != nullptr)
+	{
+		GameplayMemory->HandleSpawnWave();
+	}
+
+	return SpawnedNumber;
+}
+
+void ASpawnVolume::ProcessCrowdSpawn(const TSubclassOf<AEnemyCharacter> EnemyClass, const int32 EnemiesNumber)
+{
+	if (EnemyClass == nullptr)
+	{
+		return;
+	}
+
+	UEnemyCrowdSubsystem* CrowdSubsystem = GetWorld()->GetSubsystem<UEnemyCrowdSubsystem>();
+
+	if (CrowdSubsystem == nullptr)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < EnemiesNumber; ++Index)
+	{
+		const FRotator Rotation{0.f, RandomStream.FRandRange(0.f, 360.f), 0.f};
+		CrowdSubsystem->AddEnemy(EnemyClass, FTransform{Rotation, GetRandomPoint()});
+	}
+}
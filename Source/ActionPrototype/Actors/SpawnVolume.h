@@ -5,13 +5,14 @@
 #include "CoreMinimal.h"
 
 #include "GameFramework/Actor.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "SpawnVolume.generated.h"
 
 class UBoxComponent;
 class AEnemyCharacter;
 
 UCLASS()
-class ACTIONPROTOTYPE_API ASpawnVolume : public AActor
+class ACTIONPROTOTYPE_API ASpawnVolume : public AActor, public ITickPolicy
 {
 	GENERATED_BODY()
 
@@ -21,17 +22,41 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	/** Determines when the volume ticks. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
+
 public:
 	virtual void Tick(float DeltaTime) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
 	UFUNCTION(BlueprintImplementableEvent, Category="Spawn Volume")
 	AEnemyCharacter* OnEnemySpawned(AEnemyCharacter* SpawnedEnemy);
-	
+	/** Spawns enemy actors at random points of the volume.
+	 * @return number of spawned enemies;
+	 */
+	UFUNCTION(BlueprintCallable, Category="Spawn Volume")
+	int32 SpawnEnemies(const TSubclassOf<AEnemyCharacter> EnemyClass, const int32 EnemiesNumber);
+	FORCEINLINE TSubclassOf<AEnemyCharacter> GetCrowdEnemyClass() const { return CrowdEnemyClass; }
+	FORCEINLINE void SetCrowdEnemyClass(const TSubclassOf<AEnemyCharacter> EnemyClass) { CrowdEnemyClass = EnemyClass; }
+
 protected:
 	UFUNCTION(BlueprintPure, Category="Spawn Volume")
 	FVector GetRandomPoint() const;
 	UFUNCTION(BlueprintCallable, Category="Spawn Volume")
 	AEnemyCharacter* ProcessEnemySpawn(const TSubclassOf<AEnemyCharacter> EnemyClass, const FVector& SpawnLocation);
+	/** Adds lightweight crowd enemies at random points of the volume, they become actors only near the player. */
+	UFUNCTION(BlueprintCallable, Category="Spawn Volume|Crowd")
+	void ProcessCrowdSpawn(const TSubclassOf<AEnemyCharacter> EnemyClass, const int32 EnemiesNumber);
 private:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
 	UBoxComponent* SpawnVolume{nullptr};
+	/** Seeded from the world seed and the volume's name, so spawn points replay identically. */
+	FRandomStream RandomStream{};
+
+	/** Class of crowd enemies spawned on begin play. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spawn Volume|Crowd", meta=(AllowPrivateAccess="true"))
+	TSubclassOf<AEnemyCharacter> CrowdEnemyClass{nullptr};
+	/** Number of crowd enemies spawned on begin play. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spawn Volume|Crowd", meta=(AllowPrivateAccess="true", ClampMin="0"))
+	int32 CrowdEnemiesNumber{0};
 };
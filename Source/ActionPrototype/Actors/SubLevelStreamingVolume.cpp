@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SubLevelStreamingVolume.h"
+
+#include "ActionPrototype/Core/Subsystems/SubLevelStreamingSubsystem.h"
+#include "Components/BoxComponent.h"
+
+ASubLevelStreamingVolume::ASubLevelStreamingVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	StreamingBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("Streaming Bounds"));
+	RootComponent = StreamingBounds;
+	// The player location is tested by USubLevelStreamingSubsystem, the box only defines the area
+	StreamingBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	StreamingBounds->SetGenerateOverlapEvents(false);
+	StreamingBounds->SetCanEverAffectNavigation(false);
+	StreamingBounds->SetBoxExtent(FVector{2048.f, 2048.f, 1024.f});
+}
+
+bool ASubLevelStreamingVolume::ContainsLocation(const FVector& Location, const float Margin) const
+{
+	const FVector LocalLocation = GetActorTransform().InverseTransformPosition(Location);
+	const FVector Extent = StreamingBounds->GetUnscaledBoxExtent() + FVector{Margin} / GetActorScale3D().GetAbs();
+	return FMath::Abs(LocalLocation.X) <= Extent.X
+		&& FMath::Abs(LocalLocation.Y) <= Extent.Y
+		&& FMath::Abs(LocalLocation.Z) <= Extent.Z;
+}
+
+void ASubLevelStreamingVolume::BeginPlay()
+{
+	Super::BeginPlay();
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr)
+	{
+		SubLevelStreaming->RegisterVolume(this);
+	}
+}
+
+void ASubLevelStreamingVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr)
+	{
+		SubLevelStreaming->UnregisterVolume(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SubLevelStreamingVolume.generated.h"
+
+class UBoxComponent;
+
+/**
+ * Area in which the given sub-levels are streamed in by USubLevelStreamingSubsystem.
+ * The sub-levels must be added to the persistent level as streaming levels with Blueprint streaming method.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API ASubLevelStreamingVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ASubLevelStreamingVolume();
+
+	/** Checks if the location is inside the volume bounds expanded by the given distance. */
+	bool ContainsLocation(const FVector& Location, const float Margin = 0.f) const;
+
+	UFUNCTION(BlueprintPure, Category="Sub-Level Streaming")
+	FORCEINLINE const TArray<TSoftObjectPtr<UWorld>>& GetSubLevels() const { return SubLevels; }
+	FORCEINLINE int32 GetPriority() const { return Priority; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
+	UBoxComponent* StreamingBounds{nullptr};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Sub-Level Streaming", meta=(AllowPrivateAccess="true"))
+	TArray<TSoftObjectPtr<UWorld>> SubLevels{};
+	/** Sub-levels of volumes with higher priority are loaded first. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Sub-Level Streaming", meta=(AllowPrivateAccess="true"))
+	int32 Priority{0};
+};
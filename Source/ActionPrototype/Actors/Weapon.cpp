@@ -2,14 +2,22 @@
 
 
 #include "Weapon.h"
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Core/Subsystems/AssetStreamingSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/EffectPoolSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
 
+DECLARE_CYCLE_STAT(TEXT("Weapon Deal Damage"), STAT_WeaponDealDamage, STATGROUP_ActionPrototype);
+
 // Sets default values
 AWeapon::AWeapon()
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	
 	SkeletalMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Skeletal Mesh"));
 	RootComponent = SkeletalMesh;
@@ -26,12 +34,50 @@ AWeapon::AWeapon()
 void AWeapon::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (bIsWeaponActive)
+	{
+		UTickPolicySubsystem::ApplyTickPolicy(this);
+	}
+
 	WeaponCollision->OnComponentBeginOverlap.AddDynamic(this, &AWeapon::DealDamage);
+	UAssetStreamingSubsystem* AssetStreaming = UAssetStreamingSubsystem::Get(this);
+
+	if (AssetStreaming == nullptr)
+	{
+		return;
+	}
+
+	for (const FSoftObjectPath& AssetPath : {HitParticles.ToSoftObjectPath(), HitSound.ToSoftObjectPath()})
+	{
+		if (!AssetPath.IsNull())
+		{
+			StreamedAssets.Add(AssetPath);
+			AssetStreaming->RequestAsset(AssetPath);
+		}
+	}
+}
+
+void AWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UAssetStreamingSubsystem* AssetStreaming = UAssetStreamingSubsystem::Get(this);
+
+	if (AssetStreaming != nullptr)
+	{
+		for (const FSoftObjectPath& AssetPath : StreamedAssets)
+		{
+			AssetStreaming->ReleaseAsset(AssetPath);
+		}
+	}
+
+	StreamedAssets.Empty();
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
 void AWeapon::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
 }
 
@@ -43,12 +89,33 @@ void AWeapon::DealDamage(
 	bool bFromSweep,
 	const FHitResult& SweepResult)
 {
+	AP_SCOPE_BUDGET(Combat, WeaponDealDamage, this);
+
 	if (DamageTypeClass == nullptr)
 	{
 		return;
 	}
 
-	UGameplayStatics::ApplyDamage(OtherActor, Damage, GetOwner()->GetInstigatorController(), this, DamageTypeClass);
+	const float AppliedDamage = UGameplayStatics::ApplyDamage(
+		 OtherActor,
+		 Damage,
+		 GetOwner()->GetInstigatorController(),
+		 this,
+		 DamageTypeClass
+		);
+
+	if (AppliedDamage <= 0.f)
+	{
+		return;
+	}
+
+	UEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UEffectPoolSubsystem>();
+
+	if (EffectPool != nullptr)
+	{
+		const FVector HitLocation = bFromSweep ? FVector(SweepResult.ImpactPoint) : WeaponCollision->GetComponentLocation();
+		EffectPool->PlayEffectsAtLocation(HitParticles.Get(), HitSound.Get(), HitLocation);
+	}
 }
 
 void AWeapon::EnableCollision() const
@@ -61,3 +128,29 @@ void AWeapon::DisableCollision() const
 	WeaponCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
+void AWeapon::SetWeaponActive(const bool bIsActive)
+{
+	if (bIsWeaponActive == bIsActive)
+	{
+		return;
+	}
+
+	bIsWeaponActive = bIsActive;
+	SetActorHiddenInGame(!bIsActive);
+
+	if (bIsActive)
+	{
+		UTickPolicySubsystem::ApplyTickPolicy(this);
+	}
+	else
+	{
+		SetActorTickEnabled(false);
+	}
+
+	SkeletalMesh->SetComponentTickEnabled(bIsActive);
+
+	if (!bIsActive)
+	{
+		DisableCollision();
+	}
+}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "GameFramework/Actor.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "Weapon.generated.h"
 
 
@@ -17,9 +18,11 @@ enum class EWeaponSlot : uint8
 
 class UCapsuleComponent;
 class USkeletalMeshComponent;
+class UParticleSystem;
+class USoundBase;
 
 UCLASS()
-class ACTIONPROTOTYPE_API AWeapon : public AActor
+class ACTIONPROTOTYPE_API AWeapon : public AActor, public ITickPolicy
 {
 	GENERATED_BODY()
 
@@ -30,20 +33,34 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Determines when the weapon ticks, an inactive weapon never ticks. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
 
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon|Damage")
 	float Damage{5.f};
 	UFUNCTION()
 	void EnableCollision() const;
 	UFUNCTION()
 	void DisableCollision() const;
+	/** Shows an equipped weapon or hides a cached one, hidden weapons don't tick and have no collision. */
+	void SetWeaponActive(const bool bIsActive);
+	UFUNCTION(BlueprintPure, Category="Weapon")
+	FORCEINLINE bool IsWeaponActive() const { return bIsWeaponActive; }
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon|Damage", meta=(AllowPrivateAccess="true"))
 	TSubclassOf<UDamageType> DamageTypeClass{nullptr};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon|Effects")
+	TSoftObjectPtr<UParticleSystem> HitParticles{};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon|Effects")
+	TSoftObjectPtr<USoundBase> HitSound{};
 	
 	UFUNCTION()
 	void DealDamage(
@@ -59,4 +76,28 @@ private:
 	UCapsuleComponent* WeaponCollision{nullptr};
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
 	USkeletalMeshComponent* SkeletalMesh{nullptr};
+	bool bIsWeaponActive{true};
+	/** Hit effects requested on begin play, a hit before they're streamed in plays no effects. */
+	TArray<FSoftObjectPath> StreamedAssets{};
+};
+
+/** Weapon slot of a character, weapons are attached to the socket only when equipped. */
+USTRUCT(BlueprintType)
+struct FWeaponSlotConfig
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Slot")
+	EWeaponSlot Slot{EWeaponSlot::Right};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Slot")
+	FName SocketName{NAME_None};
+	/** Weapon equipped on begin play, none leaves the slot empty. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Slot")
+	TSoftClassPtr<AWeapon> DefaultWeaponClass{};
+	/**
+	 * Transform of the weapon relative to the socket. Weapons placed by the removed weapon components ignored the socket,
+	 * their placement is kept by leaving SocketName empty and copying the component's relative transform here.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Slot")
+	FTransform AttachOffset{FTransform::Identity};
 };
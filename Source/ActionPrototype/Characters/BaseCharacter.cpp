@@ -2,57 +2,111 @@
 
 
 #include "BaseCharacter.h"
+#include "ActionPrototype/ActionPrototype.h"
 #include "ActionPrototype/ActorComponents/BaseResourceComponent.h"
 #include "ActionPrototype/Actors/Weapon.h"
+#include "ActionPrototype/Core/Subsystems/EffectPoolSubsystem.h"
+#include "Animation/AnimMontage.h"
+#include "ActionPrototype/Core/Subsystems/RandomSeedSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Components/CapsuleComponent.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapons Spawned"), STAT_WeaponsSpawned, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapons Reused"), STAT_WeaponsReused, STATGROUP_ActionPrototype);
 
 ABaseCharacter::ABaseCharacter()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	HealthComponent = CreateDefaultSubobject<UBaseResourceComponent>(TEXT("HealthComponent"));
-
-	LeftWeaponComponent = CreateDefaultSubobject<UChildActorComponent>(TEXT("LeftWeapon"));
-	LeftWeaponComponent->SetupAttachment(GetMesh());
-	RightWeaponComponent = CreateDefaultSubobject<UChildActorComponent>(TEXT("RightWeapon"));
-	RightWeaponComponent->SetupAttachment(GetMesh());
 }
 
 void ABaseCharacter::EquipWeapon(const TSubclassOf<AWeapon> NewWeapon, const EWeaponSlot WeaponSlot)
 {
-	switch (WeaponSlot)
+	AWeapon*& SlotWeapon = WeaponSlot == EWeaponSlot::Left ? LeftWeapon : RightWeapon;
+	PendingWeaponClasses.Remove(WeaponSlot);
+
+	if (SlotWeapon != nullptr && SlotWeapon->GetClass() == NewWeapon)
 	{
-		case EWeaponSlot::Left:
-			if (LeftWeaponComponent->GetClass() == NewWeapon)
-			{
-				return;
-			}
+		return;
+	}
 
-			LeftWeaponComponent->SetChildActorClass(NewWeapon);
-			LeftWeapon = Cast<AWeapon>(LeftWeaponComponent->GetChildActor());
+	if (SlotWeapon != nullptr)
+	{
+		CacheWeapon(SlotWeapon);
+		SlotWeapon = nullptr;
+	}
 
-			if (LeftWeapon != nullptr)
-			{
-				LeftWeapon->SetOwner(this);
-			}
-			break;
-		case EWeaponSlot::Right:
-			if (RightWeaponComponent->GetClass() == NewWeapon)
-			{
-				return;
-			}
+	if (NewWeapon == nullptr)
+	{
+		return;
+	}
 
-			RightWeaponComponent->SetChildActorClass(NewWeapon);
-			RightWeapon = Cast<AWeapon>(RightWeaponComponent->GetChildActor());
+	SlotWeapon = TakeWeapon(NewWeapon);
 
-			if (RightWeapon != nullptr)
-			{
-				RightWeapon->SetOwner(this);
-			}
-			break;
+	if (SlotWeapon != nullptr)
+	{
+		AttachWeapon(SlotWeapon, WeaponSlot);
+		SlotWeapon->SetWeaponActive(true);
 	}
 }
 
+void ABaseCharacter::EquipWeaponAsync(const TSoftClassPtr<AWeapon>& NewWeapon, const EWeaponSlot WeaponSlot)
+{
+	FSoftObjectPath PreviousPath;
+	StreamedWeaponClasses.RemoveAndCopyValue(WeaponSlot, PreviousPath);
+
+	if (NewWeapon.IsNull())
+	{
+		EquipWeapon(nullptr, WeaponSlot);
+	}
+	else
+	{
+		const FSoftObjectPath WeaponPath = NewWeapon.ToSoftObjectPath();
+		StreamedWeaponClasses.Add(WeaponSlot, WeaponPath);
+		PendingWeaponClasses.Add(WeaponSlot, WeaponPath);
+		RequestStreamedAsset(
+							 WeaponPath,
+							 FOnAssetStreamed::CreateUObject(this, &ABaseCharacter::HandleWeaponStreamed, WeaponSlot, WeaponPath)
+							);
+	}
+
+	// Released after the new request, so equipping the same class again doesn't unload it in between
+	if (!PreviousPath.IsNull())
+	{
+		ReleaseStreamedAsset(PreviousPath);
+	}
+}
+
+TSoftClassPtr<AWeapon> ABaseCharacter::GetEquippedWeaponClass(const EWeaponSlot WeaponSlot) const
+{
+	const FSoftObjectPath* PendingPath = PendingWeaponClasses.Find(WeaponSlot);
+
+	if (PendingPath != nullptr)
+	{
+		return TSoftClassPtr<AWeapon>{*PendingPath};
+	}
+
+	const AWeapon* SlotWeapon = WeaponSlot == EWeaponSlot::Left ? LeftWeapon : RightWeapon;
+	return SlotWeapon != nullptr ? TSoftClassPtr<AWeapon>{SlotWeapon->GetClass()} : TSoftClassPtr<AWeapon>{};
+}
+
+void ABaseCharacter::HandleWeaponStreamed(UObject* WeaponClass, const EWeaponSlot WeaponSlot, const FSoftObjectPath WeaponPath)
+{
+	const FSoftObjectPath* PendingPath = PendingWeaponClasses.Find(WeaponSlot);
+
+	if (PendingPath == nullptr || *PendingPath != WeaponPath)
+	{
+		return;
+	}
+
+	EquipWeapon(Cast<UClass>(WeaponClass), WeaponSlot);
+}
+
 AWeapon* ABaseCharacter::GetLeftWeapon() const
 {
 	return LeftWeapon;
@@ -65,28 +119,147 @@ AWeapon* ABaseCharacter::GetRightWeapon() const
 
 void ABaseCharacter::BeginPlay()
 {
+	RandomStream = URandomSeedSubsystem::MakeStreamFor(this);
 	OnTakeAnyDamage.AddDynamic(this, &ABaseCharacter::DecreaseCurrentHealth);
 	HealthComponent->OnCurrentValueIncreased.AddDynamic(this, &ABaseCharacter::BroadcastCurrentHealthIncreased);
 	HealthComponent->OnCurrentValueDecreased.AddDynamic(this, &ABaseCharacter::BroadcastCurrentHealthDecreased);
 
-	USkeletalMeshComponent* CharacterMesh = GetMesh();
-	
-	if (CharacterMesh != nullptr)
-	{
-		LeftWeaponComponent->AttachToComponent(
-											   CharacterMesh,
-											   FAttachmentTransformRules::KeepWorldTransform,
-											   LeftWeaponSocketName
-											  );
-		RightWeaponComponent->AttachToComponent(
-												CharacterMesh,
-												FAttachmentTransformRules::KeepWorldTransform,
-												RightWeaponSocketName
-											   );
-		EquipWeapon(DefaultLeftWeaponClass, EWeaponSlot::Left);
-		EquipWeapon(DefaultRightWeaponClass, EWeaponSlot::Right);
+	if (GetMesh() != nullptr)
+	{
+		if (WeaponSlots.Num() == 0)
+		{
+			EquipWeaponAsync(DefaultLeftWeaponClass, EWeaponSlot::Left);
+			EquipWeaponAsync(DefaultRightWeaponClass, EWeaponSlot::Right);
+		}
+
+		for (const FWeaponSlotConfig& SlotConfig : WeaponSlots)
+		{
+			EquipWeaponAsync(SlotConfig.DefaultWeaponClass, SlotConfig.Slot);
+		}
 	}
+
+	RequestStreamedAsset(
+						 AttackMontage.ToSoftObjectPath(),
+						 FOnAssetStreamed::CreateUObject(this, &ABaseCharacter::HandleAttackMontageStreamed)
+						);
+	RequestStreamedAsset(DeathParticles.ToSoftObjectPath());
+	RequestStreamedAsset(DeathSound.ToSoftObjectPath());
+
 	Super::BeginPlay();
+	UTickPolicySubsystem::ApplyTickPolicy(this);
+}
+
+void ABaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Weapons aren't child actors, so they have to be destroyed with the character
+	if (EndPlayReason == EEndPlayReason::Destroyed || EndPlayReason == EEndPlayReason::RemovedFromWorld)
+	{
+		for (AWeapon* Weapon : {LeftWeapon, RightWeapon})
+		{
+			if (Weapon != nullptr)
+			{
+				Weapon->Destroy();
+			}
+		}
+
+		for (AWeapon* Weapon : CachedWeapons)
+		{
+			if (Weapon != nullptr)
+			{
+				Weapon->Destroy();
+			}
+		}
+	}
+
+	LeftWeapon = nullptr;
+	RightWeapon = nullptr;
+	CachedWeapons.Empty();
+	PendingWeaponClasses.Empty();
+	StreamedWeaponClasses.Empty();
+	UAssetStreamingSubsystem* AssetStreaming = UAssetStreamingSubsystem::Get(this);
+
+	if (AssetStreaming != nullptr)
+	{
+		for (const FSoftObjectPath& AssetPath : StreamedAssets)
+		{
+			AssetStreaming->ReleaseAsset(AssetPath);
+		}
+	}
+
+	StreamedAssets.Empty();
+	Super::EndPlay(EndPlayReason);
+}
+
+void ABaseCharacter::AttachWeapon(AWeapon* Weapon, const EWeaponSlot WeaponSlot)
+{
+	const FWeaponSlotConfig* SlotConfig = WeaponSlots.FindByPredicate(
+																	  [WeaponSlot](const FWeaponSlotConfig& Config)
+																	  {
+																		  return Config.Slot == WeaponSlot;
+																	  }
+																	 );
+
+	if (SlotConfig == nullptr)
+	{
+		Weapon->AttachToComponent(
+								  GetMesh(),
+								  FAttachmentTransformRules::SnapToTargetNotIncludingScale,
+								  WeaponSlot == EWeaponSlot::Left ? LeftWeaponSocketName : RightWeaponSocketName
+								 );
+		return;
+	}
+
+	Weapon->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, SlotConfig->SocketName);
+	Weapon->AddActorLocalTransform(SlotConfig->AttachOffset);
+}
+
+AWeapon* ABaseCharacter::TakeWeapon(const TSubclassOf<AWeapon> WeaponClass)
+{
+	const int32 CachedIndex = CachedWeapons.FindLastByPredicate(
+																 [WeaponClass](const AWeapon* Weapon)
+																 {
+																	 return Weapon != nullptr && Weapon->GetClass() == WeaponClass;
+																 }
+																);
+
+	if (CachedIndex != INDEX_NONE)
+	{
+		AWeapon* Weapon = CachedWeapons[CachedIndex];
+		CachedWeapons.RemoveAt(CachedIndex);
+		INC_DWORD_STAT(STAT_WeaponsReused);
+		return Weapon;
+	}
+
+	AP_LLM_SCOPE(Weapons);
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = this;
+	SpawnParameters.Instigator = this;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AWeapon* Weapon = GetWorld()->SpawnActor<AWeapon>(WeaponClass, GetActorTransform(), SpawnParameters);
+	INC_DWORD_STAT(STAT_WeaponsSpawned);
+	return Weapon;
+}
+
+void ABaseCharacter::CacheWeapon(AWeapon* Weapon)
+{
+	if (MaxCachedWeapons <= 0)
+	{
+		Weapon->Destroy();
+		return;
+	}
+
+	Weapon->SetWeaponActive(false);
+	CachedWeapons.Add(Weapon);
+
+	while (CachedWeapons.Num() > MaxCachedWeapons)
+	{
+		if (CachedWeapons[0] != nullptr)
+		{
+			CachedWeapons[0]->Destroy();
+		}
+
+		CachedWeapons.RemoveAt(0);
+	}
 }
 
 void ABaseCharacter::BroadcastCurrentHealthIncreased(const float Amount, const float CurrentHealth)
@@ -101,7 +274,16 @@ void ABaseCharacter::BroadcastCurrentHealthDecreased(const float Amount, const f
 
 void ABaseCharacter::ProcessCharacterDeath()
 {
+	AP_TRACE_EVENT(TEXT("Death %s"), *GetName());
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	UEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UEffectPoolSubsystem>();
+
+	if (EffectPool != nullptr)
+	{
+		EffectPool->PlayEffectsAtLocation(DeathParticles.Get(), DeathSound.Get(), GetActorLocation());
+	}
+
 	OnDeath.Broadcast();
 }
 
@@ -139,8 +321,89 @@ void ABaseCharacter::SwitchRightWeaponCollision(const bool bIsEnabled) const
 	}
 }
 
+void ABaseCharacter::CacheAttackSections(const UAnimMontage* AttackMontage, const TArray<FName>& DefaultSectionsNames)
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+	UAttackSectionSubsystem* AttackSectionSubsystem = GameInstance != nullptr
+		                                                  ? GameInstance->GetSubsystem<UAttackSectionSubsystem>()
+		                                                  : nullptr;
+
+	if (AttackSectionSubsystem == nullptr)
+	{
+		AttackSectionTable = UAttackSectionSubsystem::BuildSectionTable(AttackMontage, AttackSections, DefaultSectionsNames);
+		return;
+	}
+
+	AttackSectionTable = AttackSectionSubsystem->GetSectionTable(
+																  GetClass(),
+																  AttackMontage,
+																  AttackSections,
+																  DefaultSectionsNames
+																 );
+}
+
+void ABaseCharacter::GetDefaultAttackSectionsNames(TArray<FName>& OutSectionsNames) const
+{
+}
+
+UAnimMontage* ABaseCharacter::GetAttackMontage() const
+{
+	return AttackMontage.Get();
+}
+
+void ABaseCharacter::RequestStreamedAsset(const FSoftObjectPath& AssetPath, FOnAssetStreamed OnStreamed)
+{
+	UAssetStreamingSubsystem* AssetStreaming = UAssetStreamingSubsystem::Get(this);
+
+	if (AssetStreaming == nullptr)
+	{
+		OnStreamed.ExecuteIfBound(AssetPath.TryLoad());
+		return;
+	}
+
+	if (!AssetPath.IsNull())
+	{
+		StreamedAssets.Add(AssetPath);
+	}
+
+	AssetStreaming->RequestAsset(AssetPath, MoveTemp(OnStreamed));
+}
+
+void ABaseCharacter::ReleaseStreamedAsset(const FSoftObjectPath& AssetPath)
+{
+	UAssetStreamingSubsystem* AssetStreaming = UAssetStreamingSubsystem::Get(this);
+
+	if (AssetStreaming != nullptr && StreamedAssets.RemoveSingle(AssetPath) > 0)
+	{
+		AssetStreaming->ReleaseAsset(AssetPath);
+	}
+}
+
+void ABaseCharacter::HandleAttackMontageStreamed(UObject* Montage)
+{
+	TArray<FName> DefaultSectionsNames;
+	GetDefaultAttackSectionsNames(DefaultSectionsNames);
+	CacheAttackSections(Cast<UAnimMontage>(Montage), DefaultSectionsNames);
+}
+
+int32 ABaseCharacter::SelectAttackSection(const int32 PreviousSection) const
+{
+	return AttackSectionTable.IsValid() ? AttackSectionTable->SelectSection(RandomStream, PreviousSection) : INDEX_NONE;
+}
+
+FName ABaseCharacter::GetAttackSectionName(const int32 SectionIndex) const
+{
+	if (!AttackSectionTable.IsValid() || !AttackSectionTable->Sections.IsValidIndex(SectionIndex))
+	{
+		return NAME_None;
+	}
+
+	return AttackSectionTable->Sections[SectionIndex].SectionName;
+}
+
 void ABaseCharacter::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
 }
 
@@ -159,6 +422,16 @@ float ABaseCharacter::GetNormalisedHealth() const
 	return HealthComponent->GetNormalizedValue();
 }
 
+void ABaseCharacter::SetCurrentHealth(const float NewHealth)
+{
+	HealthComponent->SetCurrentValue(NewHealth);
+}
+
+void ABaseCharacter::RestoreHealth(const float NewMaxHealth, const float NewHealth)
+{
+	HealthComponent->RestoreValues(NewMaxHealth, NewHealth);
+}
+
 void ABaseCharacter::IncreaseCurrentHealth(const float Heal, const bool bClampToMax)
 {
 	HealthComponent->IncreaseValue(Heal, bClampToMax);
@@ -202,3 +475,46 @@ void ABaseCharacter::DecreaseMaxHealth(const float Amount, const bool bClampCurr
 	HealthComponent->DecreaseMaxValue(Amount, bClampCurrentValue);
 	OnMaxHealthDecreased.Broadcast(Amount, GetMaxHealth());
 }
+
+static void ReportCharacterComponents(UWorld* World)
+{
+	int32 CharactersNumber = 0;
+	int32 ComponentsNumber = 0;
+	int32 EquippedWeaponsNumber = 0;
+	int32 CachedWeaponsNumber = 0;
+	SIZE_T ResourceSize = 0;
+
+	for (TActorIterator<ABaseCharacter> It{World}; It; ++It)
+	{
+		const ABaseCharacter* Character = *It;
+		++CharactersNumber;
+		ComponentsNumber += Character->GetComponents().Num();
+		ResourceSize += Character->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+		for (const UActorComponent* Component : Character->GetComponents())
+		{
+			ResourceSize += Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+
+		EquippedWeaponsNumber += (Character->GetLeftWeapon() != nullptr ? 1 : 0)
+			+ (Character->GetRightWeapon() != nullptr ? 1 : 0);
+		CachedWeaponsNumber += Character->GetCachedWeaponsNumber();
+	}
+
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Characters: %d, components: %d (%.1f per character), equipped weapons: %d, cached weapons: %d, exclusive size: %.1f KB."),
+		   CharactersNumber,
+		   ComponentsNumber,
+		   CharactersNumber > 0 ? static_cast<float>(ComponentsNumber) / CharactersNumber : 0.f,
+		   EquippedWeaponsNumber,
+		   CachedWeaponsNumber,
+		   ResourceSize / 1024.f
+		  );
+}
+
+static FAutoConsoleCommandWithWorld CharacterComponentsReportCommand(
+	TEXT("ap.Characters.Report"),
+	TEXT("Logs the number of characters, their components and weapons and their exclusive memory size."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&ReportCharacterComponents));
@@ -6,9 +6,16 @@
 
 #include "GameFramework/Character.h"
 #include "ActionPrototype/Actors/Weapon.h"
+#include "ActionPrototype/Core/Subsystems/AssetStreamingSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/AttackSectionSubsystem.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
 #include "BaseCharacter.generated.h"
 
 class UBaseResourceComponent;
+class UParticleSystem;
+class USoundBase;
+class UAnimMontage;
+class UChildActorComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCurrentHealthIncreased, float, Amount, float, NewValue);
 
@@ -21,13 +28,14 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMaxHealthDecreased, float, Amoun
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCharacterDeath);
 
 UCLASS(Abstract)
-class ACTIONPROTOTYPE_API ABaseCharacter : public ACharacter
+class ACTIONPROTOTYPE_API ABaseCharacter : public ACharacter, public ITickPolicy
 {
 	GENERATED_BODY()
 
 public:
 	ABaseCharacter();
 	virtual void Tick(float DeltaTime) override;
+	virtual EGameplayTickPolicy GetTickPolicy() const override { return TickPolicy; }
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Health")
 	bool bIsInvulnerable{false};
 
@@ -37,6 +45,11 @@ public:
 	float GetMaxHealth() const;
 	UFUNCTION(BlueprintPure, Category="Character Health")
 	float GetNormalisedHealth() const;
+	/** Sets current health without broadcasting health delegates and resumes regeneration if it's needed. */
+	UFUNCTION(BlueprintCallable, Category="Character Health")
+	void SetCurrentHealth(const float NewHealth);
+	/** Sets max and current health without broadcasting health delegates, used to restore a saved character. */
+	void RestoreHealth(const float NewMaxHealth, const float NewHealth);
 	UFUNCTION(BlueprintCallable, Category="Character Health")
 	void IncreaseCurrentHealth(const float Heal, const bool bClampToMax = true);
 	UFUNCTION(BlueprintCallable, Category="Character Health")
@@ -62,14 +75,31 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Character Health")
 	FOnCharacterDeath OnDeath;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Health|Effects")
+	TSoftObjectPtr<UParticleSystem> DeathParticles{};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Health|Effects")
+	TSoftObjectPtr<USoundBase> DeathSound{};
+
 	UFUNCTION(BlueprintCallable, Category="Weapon")
 	void EquipWeapon(const TSubclassOf<AWeapon> NewWeapon, const EWeaponSlot WeaponSlot);
+	/** Streams the weapon class if it isn't resident yet and equips it once it's loaded. */
+	UFUNCTION(BlueprintCallable, Category="Weapon")
+	void EquipWeaponAsync(const TSoftClassPtr<AWeapon>& NewWeapon, const EWeaponSlot WeaponSlot);
 	UFUNCTION(BlueprintPure, Category="Weapon")
 	AWeapon* GetLeftWeapon() const;
 	UFUNCTION(BlueprintPure, Category="Weapon")
 	AWeapon* GetRightWeapon() const;
+	UFUNCTION(BlueprintPure, Category="Weapon")
+	FORCEINLINE int32 GetCachedWeaponsNumber() const { return CachedWeapons.Num(); }
+	/** Returns the class of the weapon in the slot, or of the weapon being streamed for it. */
+	TSoftClassPtr<AWeapon> GetEquippedWeaponClass(const EWeaponSlot WeaponSlot) const;
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Determines when the character ticks. Subclasses whose Tick does work in C++ set it to Always. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Tick")
+	EGameplayTickPolicy TickPolicy{EGameplayTickPolicy::OnDemand};
 
 	UFUNCTION(BlueprintImplementableEvent, Category="Character Health")
 	void OnZeroHealth();
@@ -80,6 +110,27 @@ protected:
 	UFUNCTION(BlueprintCallable, Category="Weapon")
 	void SwitchRightWeaponCollision(const bool bIsEnabled) const;
 
+	/** Resolves AttackSections against the montage once per class.
+	 * @param DefaultSectionsNames - sections with equal weights used if AttackSections is empty;
+	 */
+	void CacheAttackSections(const UAnimMontage* AttackMontage, const TArray<FName>& DefaultSectionsNames);
+	/** Sections used if AttackSections aren't set up. */
+	virtual void GetDefaultAttackSectionsNames(TArray<FName>& OutSectionsNames) const;
+	/** Returns the attack montage if it's streamed in, otherwise nullptr. */
+	UAnimMontage* GetAttackMontage() const;
+	/** Streams the given asset and keeps it resident until the character ends play. */
+	void RequestStreamedAsset(const FSoftObjectPath& AssetPath, FOnAssetStreamed OnStreamed = FOnAssetStreamed{});
+	/** Releases one request of the given asset made by RequestStreamedAsset. */
+	void ReleaseStreamedAsset(const FSoftObjectPath& AssetPath);
+	/** Returns the index of the next attack section or INDEX_NONE if there are no sections.
+	 * @param PreviousSection - index of the section played before, its combo link is followed if there is one;
+	 */
+	int32 SelectAttackSection(const int32 PreviousSection = INDEX_NONE) const;
+	FName GetAttackSectionName(const int32 SectionIndex) const;
+
+	/** Seeded from the world seed and the character's name, so the behavior replays identically. */
+	FRandomStream RandomStream{};
+
 private:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
 	UBaseResourceComponent* HealthComponent{nullptr};
@@ -90,10 +141,15 @@ private:
 	void BroadcastCurrentHealthDecreased(const float Amount, const float CurrentHealth);
 
 
-	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true"))
+	/** Always nullptr, weapons are attached to the mesh sockets of WeaponSlots. */
+	UPROPERTY(BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true", DeprecatedProperty, DeprecationMessage="Weapon components were removed, use GetLeftWeapon and WeaponSlots instead."))
 	UChildActorComponent* LeftWeaponComponent{nullptr};
-	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true"))
+	/** Always nullptr, weapons are attached to the mesh sockets of WeaponSlots. */
+	UPROPERTY(BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true", DeprecatedProperty, DeprecationMessage="Weapon components were removed, use GetRightWeapon and WeaponSlots instead."))
 	UChildActorComponent* RightWeaponComponent{nullptr};
+	/** Slots of the character class, if empty the legacy socket names and default classes are used. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true"))
+	TArray<FWeaponSlotConfig> WeaponSlots{};
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true"))
 	AWeapon* LeftWeapon{nullptr};
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true"))
@@ -103,8 +159,37 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true"))
 	FName RightWeaponSocketName{"RightWeaponSocket"};
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon", meta=(AllowPrivateAccess="true"))
-	TSubclassOf<AWeapon> DefaultLeftWeaponClass{nullptr};
+	TSoftClassPtr<AWeapon> DefaultLeftWeaponClass{};
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon", meta=(AllowPrivateAccess="true"))
-	TSubclassOf<AWeapon> DefaultRightWeaponClass{nullptr};
+	TSoftClassPtr<AWeapon> DefaultRightWeaponClass{};
+	/** Hidden weapons kept for reequipping, the most recently used ones are at the end. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Weapon", meta=(AllowPrivateAccess="true"))
+	TArray<AWeapon*> CachedWeapons{};
+	/** Maximum number of hidden weapons, the least recently used ones are destroyed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon", meta=(AllowPrivateAccess="true", ClampMin="0"))
+	int32 MaxCachedWeapons{2};
+
+	/** Attaches the weapon to the socket of the slot with its attach offset. */
+	void AttachWeapon(AWeapon* Weapon, const EWeaponSlot WeaponSlot);
+	/** Returns a cached weapon of the given class or spawns a new one. */
+	AWeapon* TakeWeapon(const TSubclassOf<AWeapon> WeaponClass);
+	/** Hides the given weapon and keeps it for reequipping. */
+	void CacheWeapon(AWeapon* Weapon);
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Attack", meta=(AllowPrivateAccess="true"))
+	TArray<FAttackSection> AttackSections{};
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Attack", meta=(AllowPrivateAccess="true"))
+	TSoftObjectPtr<UAnimMontage> AttackMontage{};
+	/** Shared between all characters of the same class. */
+	TSharedPtr<const FAttackSectionTable> AttackSectionTable{};
+	/** Assets requested from UAssetStreamingSubsystem, released on end play. */
+	TArray<FSoftObjectPath> StreamedAssets{};
+	/** Weapon classes being streamed per slot, only the latest request of a slot is equipped. */
+	TMap<EWeaponSlot, FSoftObjectPath> PendingWeaponClasses{};
+	/** Weapon classes requested per slot, a class is released when another one replaces it. */
+	TMap<EWeaponSlot, FSoftObjectPath> StreamedWeaponClasses{};
+
+	void HandleWeaponStreamed(UObject* WeaponClass, const EWeaponSlot WeaponSlot, const FSoftObjectPath WeaponPath);
+	void HandleAttackMontageStreamed(UObject* Montage);
 
 };
@@ -3,11 +3,24 @@
 
 #include "EnemyCharacter.h"
 
+#include "ActionPrototype/ActionPrototype.h"
 #include "PlayerCharacter.h"
+#include "ActionPrototype/Core/AI/EnemyDecision.h"
+#include "ActionPrototype/Core/Subsystems/AttackTokenSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/CombatTextSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/EnemyActivationSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/EnemyDirectorSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/SaveGameSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "AIModule/Classes/AIController.h"
 #include "DrawDebugHelpers.h"
 
+DECLARE_CYCLE_STAT(TEXT("Enemy Player Visibility"), STAT_EnemyPlayerVisibility, STATGROUP_ActionPrototype);
+
 void AEnemyCharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -18,6 +31,56 @@ void AEnemyCharacter::BeginPlay()
 		this->SpawnDefaultController();
 		EnemyController = Cast<AAIController>(GetController());
 	}
+
+	UEnemyActivationSubsystem* ActivationSubsystem = GetWorld()->GetSubsystem<UEnemyActivationSubsystem>();
+
+	if (ActivationSubsystem != nullptr)
+	{
+		ActivationSubsystem->RegisterEnemy(this, bStartDormant);
+	}
+
+	UEnemyDirectorSubsystem* DirectorSubsystem = GetWorld()->GetSubsystem<UEnemyDirectorSubsystem>();
+
+	if (DirectorSubsystem != nullptr)
+	{
+		DirectorSubsystem->RegisterEnemy(this);
+	}
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->RegisterActor(this);
+	}
+
+	OnCurrentHealthDecreased.AddDynamic(this, &AEnemyCharacter::ShowDamage);
+}
+
+void AEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UEnemyActivationSubsystem* ActivationSubsystem = GetWorld()->GetSubsystem<UEnemyActivationSubsystem>();
+
+	if (ActivationSubsystem != nullptr)
+	{
+		ActivationSubsystem->UnregisterEnemy(this);
+	}
+
+	UEnemyDirectorSubsystem* DirectorSubsystem = GetWorld()->GetSubsystem<UEnemyDirectorSubsystem>();
+
+	if (DirectorSubsystem != nullptr)
+	{
+		DirectorSubsystem->UnregisterEnemy(this);
+	}
+
+	USaveGameSubsystem* SaveGame = GetWorld()->GetSubsystem<USaveGameSubsystem>();
+
+	if (SaveGame != nullptr)
+	{
+		SaveGame->UnregisterActor(this);
+	}
+
+	ReleaseAttackToken();
+	Super::EndPlay(EndPlayReason);
 }
 
 AEnemyCharacter::AEnemyCharacter()
@@ -26,18 +89,34 @@ AEnemyCharacter::AEnemyCharacter()
 
 void AEnemyCharacter::Tick(float DeltaSeconds)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaSeconds);
+}
 
-	if (GetCurrentHealth() <= 0.f)
+void AEnemyCharacter::SerializePersistentState(FArchive& Archive)
+{
+	float Health = GetCurrentHealth();
+	Archive << Health;
+
+	// Dead enemies can't be brought back, their death has already been processed
+	if (!Archive.IsLoading() || GetCurrentHealth() <= 0.f)
+	{
+		return;
+	}
+
+	if (Health <= 0.f)
 	{
+		Destroy();
 		return;
 	}
-	
-	ProcessEnemyStates();
+
+	RestoreHealth(GetMaxHealth(), Health);
 }
 
 bool AEnemyCharacter::IsPlayerVisible() const
 {
+	AP_SCOPE_BUDGET(AI, EnemyPlayerVisibility, this);
+
 	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
 
 	if (PlayerCharacter == nullptr)
@@ -71,15 +150,130 @@ bool AEnemyCharacter::IsPlayerVisible() const
 
 void AEnemyCharacter::ProcessCharacterDeath()
 {
-	CurrentState = EEnemyState::Death;
+	SetCurrentState(EEnemyState::Death);
 	SwitchLeftWeaponCollision(false);
 	SwitchRightWeaponCollision(false);
 	Super::ProcessCharacterDeath();
 }
 
+void AEnemyCharacter::GetDefaultAttackSectionsNames(TArray<FName>& OutSectionsNames) const
+{
+	OutSectionsNames = AttackSectionsNames.Array();
+}
+
+void AEnemyCharacter::EnterDormancy()
+{
+	if (bIsDormant)
+	{
+		return;
+	}
+
+	bIsDormant = true;
+
+	if (EnemyController != nullptr)
+	{
+		EnemyController->StopMovement();
+		EnemyController->SetActorTickEnabled(false);
+	}
+
+	GetWorld()->GetTimerManager().PauseTimer(AttackDelayHandle);
+	ReleaseAttackToken();
+	SetActorTickEnabled(false);
+
+	UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
+	MovementComponent->StopMovementImmediately();
+	MovementComponent->SetComponentTickEnabled(false);
+
+	USkeletalMeshComponent* CharacterMesh = GetMesh();
+	CharacterMesh->bPauseAnims = true;
+	CharacterMesh->SetComponentTickEnabled(false);
+
+	// The collision of a corpse isn't restored, so it isn't recorded either
+	if (GetCurrentHealth() > 0.f)
+	{
+		AwakeMeshCollision = CharacterMesh->GetCollisionEnabled();
+	}
+
+	CharacterMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetCapsuleComponent()->SetGenerateOverlapEvents(false);
+
+	for (AWeapon* Weapon : {GetLeftWeapon(), GetRightWeapon()})
+	{
+		if (Weapon != nullptr)
+		{
+			Weapon->SetActorTickEnabled(false);
+		}
+	}
+
+	OnDormancyStarted.Broadcast();
+}
+
+void AEnemyCharacter::ExitDormancy()
+{
+	if (!bIsDormant)
+	{
+		return;
+	}
+
+	bIsDormant = false;
+	USkeletalMeshComponent* CharacterMesh = GetMesh();
+	CharacterMesh->bPauseAnims = false;
+	CharacterMesh->SetComponentTickEnabled(true);
+
+	// A corpse only shows its mesh, it doesn't move, attack or collide
+	if (GetCurrentHealth() <= 0.f)
+	{
+		OnDormancyFinished.Broadcast();
+		return;
+	}
+
+	if (EnemyController != nullptr)
+	{
+		EnemyController->SetActorTickEnabled(true);
+	}
+
+	GetWorld()->GetTimerManager().UnPauseTimer(AttackDelayHandle);
+	UTickPolicySubsystem::ApplyTickPolicy(this);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	CharacterMesh->SetCollisionEnabled(AwakeMeshCollision);
+	GetCapsuleComponent()->SetGenerateOverlapEvents(true);
+
+	for (AWeapon* Weapon : {GetLeftWeapon(), GetRightWeapon()})
+	{
+		if (Weapon != nullptr)
+		{
+			UTickPolicySubsystem::ApplyTickPolicy(Weapon);
+		}
+	}
+
+	OnDormancyFinished.Broadcast();
+}
+
+void AEnemyCharacter::RestoreState(const EEnemyState State)
+{
+	switch (State)
+	{
+		case EEnemyState::Chase:
+			ChasePlayer();
+			break;
+		case EEnemyState::Attack:
+			SetCurrentState(EEnemyState::Attack);
+			StartAttackDelayTimer();
+			break;
+		case EEnemyState::Death:
+			break;
+		default:
+			SetCurrentState(State);
+			break;
+	}
+}
+
 void AEnemyCharacter::StartAttackDelayTimer()
 {
-	const float DelayTimer = FMath::FRandRange(MinAttackDelay, MaxAttackDelay);
+	// The attack is over, let waiting enemies take the token during the delay
+	ReleaseAttackToken();
+	const float DelayTimer = RandomStream.FRandRange(MinAttackDelay, MaxAttackDelay);
+	INC_DWORD_STAT(STAT_GameplayTimersSet);
 	GetWorld()->GetTimerManager().SetTimer(
 										   AttackDelayHandle,
 										   this,
@@ -89,6 +283,16 @@ void AEnemyCharacter::StartAttackDelayTimer()
 										  );
 }
 
+void AEnemyCharacter::SetCurrentState(const EEnemyState NewState)
+{
+	if (NewState != EEnemyState::Attack)
+	{
+		ReleaseAttackToken();
+	}
+
+	CurrentState = NewState;
+}
+
 void AEnemyCharacter::ChasePlayer()
 {
 	AActor* PlayerActor = Cast<AActor>(UGameplayStatics::GetPlayerCharacter(this, 0));
@@ -100,16 +304,16 @@ void AEnemyCharacter::ChasePlayer()
 
 	if (Cast<APlayerCharacter>(PlayerActor)->GetCurrentHealth() <= 0.f)
 	{
-		CurrentState = EEnemyState::Idle;
+		SetCurrentState(EEnemyState::Idle);
 		return;
 	}
 
 	if (CurrentState != EEnemyState::Chase)
 	{
-		CurrentState = EEnemyState::Chase;
+		SetCurrentState(EEnemyState::Chase);
 	}
 
-	const float TargetDistance = FMath::FRandRange(ChaseMinDistance, ChaseMaxDistance);
+	const float TargetDistance = RandomStream.FRandRange(ChaseMinDistance, ChaseMaxDistance);
 	EnemyController->MoveToActor(PlayerActor, TargetDistance);
 }
 
@@ -124,41 +328,86 @@ void AEnemyCharacter::AttackPlayer()
 
 	if (PlayerCharacter->GetCurrentHealth() <= 0.f)
 	{
-		CurrentState = EEnemyState::Idle;
+		SetCurrentState(EEnemyState::Idle);
+		UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+
+		if (AnimInstance != nullptr)
+		{
+			AnimInstance->StopAllMontages(0.f);
+		}
+
+		return;
+	}
+
+	if (!RequestAttackToken())
+	{
+		HoldPosition(PlayerCharacter);
+		return;
 	}
 
 	if (CurrentState != EEnemyState::Attack)
 	{
-		CurrentState = EEnemyState::Attack;
+		SetCurrentState(EEnemyState::Attack);
 	}
 
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	UAnimMontage* AttackMontage = GetAttackMontage();
 
 	if (AnimInstance != nullptr && AttackMontage != nullptr)
 	{
-		if (AttackSectionsNames.Num() == 0)
-		{
-			return;
-		}
+		const int32 SectionIndex = SelectAttackSection();
 
-		if (PlayerCharacter->GetCurrentHealth() <= 0.f)
+		if (SectionIndex == INDEX_NONE)
 		{
-			AnimInstance->StopAllMontages(0.f);
 			return;
 		}
 
-		const int32 AnimMontageSection = FMath::RandRange(0, 2);
-		const FName SectionName = AttackSectionsNames.Array()[AnimMontageSection];
 		AnimInstance->Montage_Play(AttackMontage, 1.f);
-		AnimInstance->Montage_JumpToSection(SectionName, AttackMontage);
+		AnimInstance->Montage_JumpToSection(GetAttackSectionName(SectionIndex), AttackMontage);
+	}
+
+	FacePlayer(PlayerCharacter);
+}
+
+void AEnemyCharacter::HoldPosition(const AActor* PlayerActor)
+{
+	if (CurrentState != EEnemyState::Hold)
+	{
+		SetCurrentState(EEnemyState::Hold);
+
+		if (EnemyController != nullptr && EnemyController->IsFollowingAPath())
+		{
+			EnemyController->StopMovement();
+		}
 	}
 
+	FacePlayer(PlayerActor);
+}
+
+void AEnemyCharacter::FacePlayer(const AActor* PlayerActor)
+{
 	// Terrible solution, but the better one is overkill for this project
-	FVector DirectionToPlayer = PlayerCharacter->GetActorLocation() - GetActorLocation();
+	FVector DirectionToPlayer = PlayerActor->GetActorLocation() - GetActorLocation();
 	DirectionToPlayer.Normalize();
 	SetActorRotation(DirectionToPlayer.Rotation());
 }
 
+bool AEnemyCharacter::RequestAttackToken()
+{
+	UAttackTokenSubsystem* AttackTokenSubsystem = GetWorld()->GetSubsystem<UAttackTokenSubsystem>();
+	return AttackTokenSubsystem == nullptr || AttackTokenSubsystem->RequestToken(this);
+}
+
+void AEnemyCharacter::ReleaseAttackToken()
+{
+	UAttackTokenSubsystem* AttackTokenSubsystem = GetWorld()->GetSubsystem<UAttackTokenSubsystem>();
+
+	if (AttackTokenSubsystem != nullptr)
+	{
+		AttackTokenSubsystem->ReleaseToken(this);
+	}
+}
+
 void AEnemyCharacter::ContinueAttacking()
 {
 	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
@@ -170,7 +419,7 @@ void AEnemyCharacter::ContinueAttacking()
 
 	if (PlayerCharacter->GetCurrentHealth() <= 0.f)
 	{
-		CurrentState = EEnemyState::Idle;
+		SetCurrentState(EEnemyState::Idle);
 		return;
 	}
 
@@ -186,108 +435,57 @@ void AEnemyCharacter::ContinueAttacking()
 	}
 	else
 	{
-		CurrentState = EEnemyState::Idle;
+		SetCurrentState(EEnemyState::Idle);
 	}
 }
 
-void AEnemyCharacter::ProcessEnemyStates()
+bool AEnemyCharacter::CanMakeDecision() const
 {
-	if (EnemyController == nullptr)
-	{
-		return;
-	}
-	
-	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+	return !bIsDormant && EnemyController != nullptr && GetCurrentHealth() > 0.f;
+}
 
-	if (PlayerCharacter == nullptr)
-	{
-		return;
-	}
+void AEnemyCharacter::GatherDecisionInput(
+	const FPlayerDecisionInput& PlayerInput,
+	const EEnemyRangeBucket RangeBucket,
+	FEnemyDecisionInput& OutInput) const
+{
+	OutInput.RangeBucket = RangeBucket;
+	OutInput.CurrentState = CurrentState;
+	OutInput.bIsFollowingPath = EnemyController->IsFollowingAPath();
+	OutInput.bIsPlayerVisible = PlayerInput.bIsAlive
+	                            && RangeBucket != EEnemyRangeBucket::OutOfRange
+	                            && IsPlayerVisible();
+}
 
-	const bool bIsFollowingPath = EnemyController->IsFollowingAPath();
-	
-	if (PlayerCharacter->GetCurrentHealth() <= 0.f)
+void AEnemyCharacter::ApplyDecision(const FEnemyCommand& Command)
+{
+	if (Command.bStopMovement && EnemyController != nullptr)
 	{
-		if (CurrentState != EEnemyState::Idle)
-		{
-			CurrentState = EEnemyState::Idle;
-		}
-
-		if (bIsFollowingPath)
-		{
-			EnemyController->StopMovement();
-		}
-		
-		return;
+		EnemyController->StopMovement();
 	}
 
-	const float DistanceToPlayer = GetDistanceTo(PlayerCharacter);
-
-	if (DistanceToPlayer > AggroDistance)
+	switch (Command.Action)
 	{
-		return;
+		case EEnemyAction::SetIdle:
+			SetCurrentState(EEnemyState::Idle);
+			break;
+		case EEnemyAction::Chase:
+			ChasePlayer();
+			break;
+		case EEnemyAction::Attack:
+			AttackPlayer();
+			break;
+		default:
+			break;
 	}
+}
 
-	const bool bIsPlayerVisible = IsPlayerVisible();
+void AEnemyCharacter::ShowDamage(const float Amount, const float NewHealth)
+{
+	UCombatTextSubsystem* CombatText = GetWorld()->GetSubsystem<UCombatTextSubsystem>();
 
-	switch (CurrentState)
+	if (CombatText != nullptr)
 	{
-		case EEnemyState::Idle:
-			if (!bIsPlayerVisible || PlayerCharacter->GetCurrentHealth() <= 0.f)
-			{
-				return;
-			}
-
-			if (DistanceToPlayer < AttackRadius)
-			{
-				AttackPlayer();
-			}
-			else if (DistanceToPlayer < AggroDistance)
-			{
-				ChasePlayer();
-			}
-			break;
-		case EEnemyState::Chase:
-			if (!bIsPlayerVisible || PlayerCharacter->GetCurrentHealth() <= 0.f)
-			{
-				if (bIsFollowingPath)
-				{
-					EnemyController->StopMovement();
-				}
-
-				CurrentState = EEnemyState::Idle;
-				return;
-			}
-		
-			if (DistanceToPlayer < AttackRadius)
-			{
-				if (bIsFollowingPath)
-				{
-					EnemyController->StopMovement();
-				}
-
-				AttackPlayer();
-			}
-			else if (DistanceToPlayer < AggroDistance)
-			{
-				ChasePlayer();
-			}
-			else
-			{
-				CurrentState = EEnemyState::Idle;
-
-				if (bIsFollowingPath)
-				{
-					EnemyController->StopMovement();
-				}
-			}
-			break;
-		case EEnemyState::Attack:
-			if (!bIsPlayerVisible)
-			{
-				CurrentState = EEnemyState::Idle;
-				return;
-			}
-			break;
+		CombatText->AddDamage(this, Amount);
 	}
-}
\ No newline at end of file
+}
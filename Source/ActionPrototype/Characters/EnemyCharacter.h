@@ -4,36 +4,50 @@
 
 #include "CoreMinimal.h"
 #include "BaseCharacter.h"
+#include "ActionPrototype/Interfaces/PersistentState.h"
 #include "EnemyCharacter.generated.h"
 
 class USphereComponent;
 class AAIController;
+struct FEnemyDecisionInput;
+struct FPlayerDecisionInput;
+struct FEnemyCommand;
+enum class EEnemyRangeBucket : uint8;
 
 class UAnimMontage;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyDormancyStarted);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyDormancyFinished);
+
 UENUM()
 enum class EEnemyState : uint8
 {
 	Idle,
 	Chase,
 	Attack,
-	Death
+	Death,
+	/** Waits in attack range for a free attack token. */
+	Hold
 };
 
 /**
  * 
  */
 UCLASS()
-class ACTIONPROTOTYPE_API AEnemyCharacter : public ABaseCharacter
+class ACTIONPROTOTYPE_API AEnemyCharacter : public ABaseCharacter, public IPersistentState
 {
 	GENERATED_BODY()
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	AEnemyCharacter();
 	virtual void Tick(float DeltaSeconds) override;
+	/** Stores health, an enemy restored with no health is destroyed. */
+	virtual void SerializePersistentState(FArchive& Archive) override;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Enemy|State")
 	EEnemyState InitialState{EEnemyState::Idle};
 
@@ -46,20 +60,56 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Enemey|AI")
 	float ChaseMaxDistance{128.f};
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Enemy|Attack")
+	/** Sections played with equal weights if AttackSections aren't set up. Shared by the class like its table. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Enemy|Attack")
 	TSet<FName> AttackSectionsNames{};
 
+	/** Determines if an enemy begins play asleep until the player comes close. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Enemy|Dormancy")
+	bool bStartDormant{true};
+	/** Disables tick, animation, movement and most of the collision of an enemy. */
+	void EnterDormancy();
+	/** Restores everything disabled by EnterDormancy. */
+	void ExitDormancy();
+	UFUNCTION(BlueprintPure, Category="Enemy|Dormancy")
+	FORCEINLINE bool IsDormant() const { return bIsDormant; }
+
+	/** Calls when an enemy falls asleep. */
+	UPROPERTY(BlueprintAssignable, Category="Enemy|Dormancy")
+	FOnEnemyDormancyStarted OnDormancyStarted;
+	/** Calls when an enemy wakes up. */
+	UPROPERTY(BlueprintAssignable, Category="Enemy|Dormancy")
+	FOnEnemyDormancyFinished OnDormancyFinished;
+
+	UFUNCTION(BlueprintPure, Category="Enemy|State")
+	FORCEINLINE EEnemyState GetCurrentState() const { return CurrentState; }
+	/** Puts a freshly spawned enemy into the state it had as a lightweight crowd entity. */
+	void RestoreState(const EEnemyState State);
+
+	/** Determines if an enemy should be updated by the enemy director this frame. */
+	bool CanMakeDecision() const;
+	/** Fills the decision snapshot of an enemy, visibility is traced only if the player is in aggro range. */
+	void GatherDecisionInput(
+		const FPlayerDecisionInput& PlayerInput,
+		const EEnemyRangeBucket RangeBucket,
+		FEnemyDecisionInput& OutInput) const;
+	/** Applies the command made by the enemy director. */
+	void ApplyDecision(const FEnemyCommand& Command);
+
 protected:
 	bool IsPlayerVisible() const;
 	virtual void ProcessCharacterDeath() override;
+	virtual void GetDefaultAttackSectionsNames(TArray<FName>& OutSectionsNames) const override;
 
 private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Enemy|State", meta=(AllowPrivateAccess="true"))
 	EEnemyState CurrentState{EEnemyState::Idle};
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Enemy|AI", meta=(AllowPrivateAccess="true"))
 	AAIController* EnemyController{nullptr};
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Enemy|Attack", meta=(AllowPrivateAccess="true"))
-	UAnimMontage* AttackMontage{nullptr};
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Enemy|Dormancy", meta=(AllowPrivateAccess="true"))
+	bool bIsDormant{false};
+	/** Mesh collision before entering dormancy, restored on waking up. */
+	TEnumAsByte<ECollisionEnabled::Type> AwakeMeshCollision{ECollisionEnabled::NoCollision};
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Enemy|Attack", meta=(AllowPrivateAccess="true"))
 	float MinAttackDelay{0.5f};
@@ -71,10 +121,19 @@ private:
 	void StartAttackDelayTimer();
 	
 	
+	void SetCurrentState(const EEnemyState NewState);
 	void ChasePlayer();
 	void AttackPlayer();
+	/** Stops and faces the player while waiting for an attack token. */
+	void HoldPosition(const AActor* PlayerActor);
+	void FacePlayer(const AActor* PlayerActor);
+	/** Returns true if the enemy is allowed to attack, always true if there is no attack token subsystem. */
+	bool RequestAttackToken();
+	void ReleaseAttackToken();
 	UFUNCTION(BlueprintCallable, Category="Enemy|Attack")
 	void ContinueAttacking();
 
-	void ProcessEnemyStates();
+	/** Shows the damage number and the health bar of the enemy. */
+	UFUNCTION()
+	void ShowDamage(const float Amount, const float NewHealth);
 };
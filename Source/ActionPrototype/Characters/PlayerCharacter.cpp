@@ -2,19 +2,29 @@
 
 
 #include "PlayerCharacter.h"
+#include "ActionPrototype/ActionPrototype.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "ActionPrototype/ActorComponents/BaseResourceComponent.h"
 #include "ActionPrototype/Actors/Weapon.h"
 #include "ActionPrototype/Actors/Pickups/BasePickupItem.h"
+#include "ActionPrototype/Core/Data/PlayerSnapshot.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/LevelTransitionSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/PickupSubsystem.h"
+#include "ActionPrototype/Core/Subsystems/TickPolicySubsystem.h"
 #include "ActionPrototype/Interfaces/ReactToInteraction.h"
 #include "Components/CapsuleComponent.h"
 #include "Animation/AnimInstance.h"
 
+DECLARE_CYCLE_STAT(TEXT("Nearby Pickups Update"), STAT_NearbyPickupsUpdate, STATGROUP_ActionPrototype);
+
 APlayerCharacter::APlayerCharacter()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	// Nearby pickups are updated every frame
+	TickPolicy = EGameplayTickPolicy::Always;
 
 	// Create and adjust Stamina component
 	StaminaComponent = CreateDefaultSubobject<UBaseResourceComponent>(TEXT("Stamina Component"));
@@ -67,10 +77,16 @@ void APlayerCharacter::BeginPlay()
 
 	Super::BeginPlay();
 
+	ULevelTransitionSubsystem* LevelTransition = ULevelTransitionSubsystem::Get(this);
+
+	if (LevelTransition != nullptr)
+	{
+		LevelTransition->RestorePlayerSnapshot(this);
+	}
+
 	OnPlayerSpawned.Broadcast();
 
 	GetCapsuleComponent()->OnComponentBeginOverlap.AddDynamic(this, &APlayerCharacter::AddToInteractionQueue);
-	GetCapsuleComponent()->OnComponentBeginOverlap.AddDynamic(this, &APlayerCharacter::ActivatePickupEffect);
 	GetCapsuleComponent()->OnComponentEndOverlap.AddDynamic(this, &APlayerCharacter::RemoveFromInteractionQueue);
 }
 
@@ -80,9 +96,16 @@ void APlayerCharacter::ProcessCharacterDeath()
 	Super::ProcessCharacterDeath();
 }
 
+void APlayerCharacter::GetDefaultAttackSectionsNames(TArray<FName>& OutSectionsNames) const
+{
+	OutSectionsNames = {FName{TEXT("Attack_1")}, FName{TEXT("Attack_2")}};
+}
+
 void APlayerCharacter::Tick(float DeltaTime)
 {
+	AP_SCOPE_TICK_COST(this);
 	Super::Tick(DeltaTime);
+	UpdateNearbyPickups(DeltaTime);
 }
 
 bool APlayerCharacter::SetCameraYawSensitivity(const float NewSensitivity)
@@ -199,6 +222,29 @@ int32 APlayerCharacter::GetCoins() const
 	return Coins;
 }
 
+void APlayerCharacter::WriteSnapshot(FPlayerSnapshot& OutSnapshot) const
+{
+	OutSnapshot.Health = GetCurrentHealth();
+	OutSnapshot.MaxHealth = GetMaxHealth();
+	OutSnapshot.Stamina = GetCurrentStamina();
+	OutSnapshot.MaxStamina = GetMaxStamina();
+	OutSnapshot.Coins = Coins;
+	OutSnapshot.MagnetRadius = MagnetRadius;
+	OutSnapshot.LeftWeaponClass = GetEquippedWeaponClass(EWeaponSlot::Left);
+	OutSnapshot.RightWeaponClass = GetEquippedWeaponClass(EWeaponSlot::Right);
+}
+
+void APlayerCharacter::ApplySnapshot(const FPlayerSnapshot& Snapshot)
+{
+	RestoreHealth(Snapshot.MaxHealth, Snapshot.Health);
+	StaminaComponent->RestoreValues(Snapshot.MaxStamina, Snapshot.Stamina);
+	Coins = FMath::Max(Snapshot.Coins, 0);
+	MagnetRadius = FMath::Max(Snapshot.MagnetRadius, 0.f);
+	// Replaces the default weapons requested in BeginPlay, only the latest request of a slot is equipped
+	EquipWeaponAsync(Snapshot.LeftWeaponClass, EWeaponSlot::Left);
+	EquipWeaponAsync(Snapshot.RightWeaponClass, EWeaponSlot::Right);
+}
+
 void APlayerCharacter::SetSprintStaminaDecreaseFrequency(const float NewFrequency)
 {
 	if (NewFrequency <= 0.f)
@@ -283,19 +329,60 @@ void APlayerCharacter::RemoveFromInteractionQueue(
 	}
 }
 
-void APlayerCharacter::ActivatePickupEffect(
-	UPrimitiveComponent* OverlappedComponent,
-	AActor* OtherActor,
-	UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex,
-	bool bFromSweep,
-	const FHitResult& SweepResult)
+void APlayerCharacter::UpdateNearbyPickups(const float DeltaTime)
 {
-	ABasePickupItem* Pickup = Cast<ABasePickupItem>(OtherActor);
+	AP_SCOPE_BUDGET(Interactables, NearbyPickupsUpdate, this);
 
-	if (Pickup && !Pickup->GetClass()->ImplementsInterface(UReactToInteraction::StaticClass()))
+	UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+
+	if (PickupSubsystem == nullptr || GetCurrentHealth() <= 0.f)
+	{
+		return;
+	}
+
+	const UCapsuleComponent* Capsule = GetCapsuleComponent();
+	const FVector CapsuleCenter = Capsule->GetComponentLocation();
+	const FVector SegmentOffset = FVector(0.f, 0.f, Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere());
+	const FVector SegmentStart = CapsuleCenter - SegmentOffset;
+	const FVector SegmentEnd = CapsuleCenter + SegmentOffset;
+	const float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	const float QueryRadius = FMath::Max(CapsuleRadius, MagnetRadius);
+
+	PickupSubsystem->QueryPickups(SegmentStart, SegmentEnd, QueryRadius, NearbyPickups);
+	InteractablePickupsInRange.Reset();
+
+	for (ABasePickupItem* Pickup : NearbyPickups)
+	{
+		const float Distance = FMath::PointDistToSegment(Pickup->GetActorLocation(), SegmentStart, SegmentEnd);
+		const bool bIsInRange = Distance <= CapsuleRadius + Pickup->GetPickupRadius();
+		const bool bIsInteractable = Pickup->GetClass()->ImplementsInterface(UReactToInteraction::StaticClass());
+
+		if (bIsInteractable)
+		{
+			if (bIsInRange)
+			{
+				InteractablePickupsInRange.Add(Pickup);
+				InteractionQueue.Add(Pickup);
+			}
+		}
+		else if (bIsInRange)
+		{
+			Pickup->ProcessPickup(this);
+		}
+		else if (Pickup->bIsMagnetic)
+		{
+			Pickup->MoveTowards(CapsuleCenter, MagnetSpeed * DeltaTime);
+		}
+	}
+
+	for (auto Iterator = InteractionQueue.CreateIterator(); Iterator; ++Iterator)
 	{
-		Pickup->ProcessPickup(this);
+		const bool bIsPickup = *Iterator == nullptr || Cast<ABasePickupItem>(*Iterator) != nullptr;
+
+		if (bIsPickup && !InteractablePickupsInRange.Contains(*Iterator))
+		{
+			Iterator.RemoveCurrent();
+		}
 	}
 }
 
@@ -333,6 +420,7 @@ void APlayerCharacter::StartDecreaseStamina()
 
 	if (!TimerManager.IsTimerActive(DecreaseDeltaTimeHandle))
 	{
+		INC_DWORD_STAT(STAT_GameplayTimersSet);
 		TimerManager.SetTimer(
 							  DecreaseDeltaTimeHandle,
 							  this,
@@ -391,6 +479,8 @@ void APlayerCharacter::ProcessSprintAction()
 
 void APlayerCharacter::Attack()
 {
+	UAnimMontage* AttackMontage = GetAttackMontage();
+
 	if ((GetLeftWeapon() == nullptr && GetRightWeapon() == nullptr) || AttackMontage == nullptr)
 	{
 		return;
@@ -406,16 +496,22 @@ void APlayerCharacter::Attack()
 		return;
 	}
 
+	const int32 SectionIndex = SelectAttackSection(AttackSectionIndex);
+
+	if (SectionIndex == INDEX_NONE)
+	{
+		return;
+	}
+
 	DecreaseStamina(AttackStaminaCost);
 	bIsAttacking = true;
+	AttackSectionIndex = SectionIndex;
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 
 	if (AnimInstance != nullptr)
 	{
-		const int32 AnimMontageSection = FMath::RandRange(0, 1);
-		const FName SectionName = AnimMontageSection > 0 ? "Attack_1" : "Attack_2";
 		AnimInstance->Montage_Play(AttackMontage, 1.f);
-		AnimInstance->Montage_JumpToSection(SectionName, AttackMontage);
+		AnimInstance->Montage_JumpToSection(GetAttackSectionName(SectionIndex), AttackMontage);
 	}
 }
 
@@ -433,6 +529,11 @@ void APlayerCharacter::FinishAttack()
 {
 	bIsAttacking = false;
 
+	if (!bAttackPressed)
+	{
+		AttackSectionIndex = INDEX_NONE;
+	}
+
 	if (bAttackPressed && !bIsAttacking)
 	{
 		Attack();
@@ -11,6 +11,8 @@ class UCameraComponent;
 class UBaseResourceComponent;
 class AWeapon;
 class UAnimMontage;
+class ABasePickupItem;
+struct FPlayerSnapshot;
 
 UENUM(BlueprintType)
 enum class EStaminaStatus : uint8
@@ -83,6 +85,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Player|Sprint")
 	void SetSprintStaminaDecreaseFrequency(const float NewFrequency);
 
+	/** Fills the snapshot carried over level transitions. */
+	void WriteSnapshot(FPlayerSnapshot& OutSnapshot) const;
+	/** Restores resources, coins, weapons and modifiers without broadcasting their delegates. */
+	void ApplySnapshot(const FPlayerSnapshot& Snapshot);
+
 	UPROPERTY(BlueprintAssignable, Category="Player|Stamina")
 	FOnStaminaIncreased OnStaminaIncreased;
 	UPROPERTY(BlueprintAssignable, Category="Player|Stamina")
@@ -97,6 +104,7 @@ public:
 protected:
 	virtual void BeginPlay() override;
 	virtual void ProcessCharacterDeath() override;
+	virtual void GetDefaultAttackSectionsNames(TArray<FName>& OutSectionsNames) const override;
 
 private:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite, Category="Components", meta=(AllowPrivateAccess = "true"))
@@ -143,14 +151,31 @@ private:
 		AActor* OtherActor,
 		UPrimitiveComponent* OtherComp,
 		int32 OtherBodyIndex);
-	UFUNCTION()
-	void ActivatePickupEffect(
-		UPrimitiveComponent* OverlappedComponent,
-		AActor* OtherActor,
-		UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex,
-		bool bFromSweep,
-		const FHitResult& SweepResult);
+
+	/** Radius in which magnetic pickups are pulled towards the player. If == 0.0 the magnet is disabled. */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category="Player|Pickups",
+		meta=(AllowPrivateAccess="true", ClampMin="0.0")
+	)
+	float MagnetRadius{0.f};
+	/** Speed with which magnetic pickups move towards the player. */
+	UPROPERTY(
+		EditAnywhere,
+		BlueprintReadWrite,
+		Category="Player|Pickups",
+		meta=(AllowPrivateAccess="true", ClampMin="0.0")
+	)
+	float MagnetSpeed{600.f};
+	/** Pickups found by the last query, kept as a member to reuse its allocation. */
+	UPROPERTY()
+	TArray<ABasePickupItem*> NearbyPickups{};
+	/** Interactable pickups which are in the capsule radius during the current frame. */
+	UPROPERTY()
+	TArray<AActor*> InteractablePickupsInRange{};
+	/** Queries UPickupSubsystem around the capsule, collects pickups and pulls magnetic ones. */
+	void UpdateNearbyPickups(const float DeltaTime);
 
 	const TArray<float> StaminaThresholds{0.5f, 0.25f};
 	UFUNCTION()
@@ -186,12 +211,12 @@ private:
 	UFUNCTION()
 	void ProcessSprintAction();
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Player|Attack", meta=(AllowPrivateAccess="true"))
-	UAnimMontage* AttackMontage{nullptr};
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Player|Attack", meta=(AllowPrivateAccess="true"))
 	bool bAttackPressed{false};
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Player|Attack", meta=(AllowPrivateAccess="true"))
 	bool bIsAttacking{false};
+	/** Index of the section played by the current attack, its combo link is followed while attack is held. */
+	int32 AttackSectionIndex{INDEX_NONE};
 	UFUNCTION()
 	void Attack();
 	UFUNCTION()
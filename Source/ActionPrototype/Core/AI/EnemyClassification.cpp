@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyClassification.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "HAL/IConsoleManager.h"
+
+void FEnemyRangeInputs::Add(const FVector& Location, const float AggroDistance, const float AttackRadius)
+{
+	X.Add(Location.X);
+	Y.Add(Location.Y);
+	Z.Add(Location.Z);
+	AggroDistances.Add(AggroDistance);
+	AttackRadii.Add(AttackRadius);
+}
+
+void FEnemyRangeInputs::Reset()
+{
+	X.Reset();
+	Y.Reset();
+	Z.Reset();
+	AggroDistances.Reset();
+	AttackRadii.Reset();
+}
+
+static FORCEINLINE EEnemyRangeBucket ClassifyEnemy(
+	const FEnemyRangeInputs& Inputs,
+	const FVector& PlayerLocation,
+	const int32 Index)
+{
+	const float DistanceSquared = FMath::Square(Inputs.X[Index] - PlayerLocation.X)
+	                              + FMath::Square(Inputs.Y[Index] - PlayerLocation.Y)
+	                              + FMath::Square(Inputs.Z[Index] - PlayerLocation.Z);
+
+	if (DistanceSquared > FMath::Square(Inputs.AggroDistances[Index]))
+	{
+		return EEnemyRangeBucket::OutOfRange;
+	}
+
+	return DistanceSquared < FMath::Square(Inputs.AttackRadii[Index])
+		       ? EEnemyRangeBucket::Attack
+		       : EEnemyRangeBucket::Aggro;
+}
+
+void EnemyClassification::Classify(
+	const FEnemyRangeInputs& Inputs,
+	const FVector& PlayerLocation,
+	TArray<EEnemyRangeBucket>& OutBuckets)
+{
+	const int32 InputsNumber = Inputs.Num();
+	OutBuckets.SetNumUninitialized(InputsNumber, false);
+
+	const VectorRegister PlayerX = VectorSetFloat1(PlayerLocation.X);
+	const VectorRegister PlayerY = VectorSetFloat1(PlayerLocation.Y);
+	const VectorRegister PlayerZ = VectorSetFloat1(PlayerLocation.Z);
+	const int32 VectorizedNumber = InputsNumber & ~3;
+	EEnemyRangeBucket* Buckets = OutBuckets.GetData();
+
+	for (int32 Index = 0; Index < VectorizedNumber; Index += 4)
+	{
+		const VectorRegister DeltaX = VectorSubtract(VectorLoad(&Inputs.X[Index]), PlayerX);
+		const VectorRegister DeltaY = VectorSubtract(VectorLoad(&Inputs.Y[Index]), PlayerY);
+		const VectorRegister DeltaZ = VectorSubtract(VectorLoad(&Inputs.Z[Index]), PlayerZ);
+		VectorRegister DistanceSquared = VectorMultiply(DeltaX, DeltaX);
+		DistanceSquared = VectorMultiplyAdd(DeltaY, DeltaY, DistanceSquared);
+		DistanceSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, DistanceSquared);
+
+		const VectorRegister AggroDistances = VectorLoad(&Inputs.AggroDistances[Index]);
+		const VectorRegister AttackRadii = VectorLoad(&Inputs.AttackRadii[Index]);
+		const uint32 OutOfRangeMask = VectorMaskBits(
+													 VectorCompareGT(
+																	 DistanceSquared,
+																	 VectorMultiply(AggroDistances, AggroDistances)
+																	)
+													);
+		const uint32 AttackMask = VectorMaskBits(
+												 VectorCompareLT(DistanceSquared, VectorMultiply(AttackRadii, AttackRadii))
+												);
+
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const uint32 OutOfRangeBit = (OutOfRangeMask >> Lane) & 1;
+			const uint32 AttackBit = (AttackMask >> Lane) & 1;
+			Buckets[Index + Lane] = static_cast<EEnemyRangeBucket>((1 + AttackBit) * (1 - OutOfRangeBit));
+		}
+	}
+
+	for (int32 Index = VectorizedNumber; Index < InputsNumber; ++Index)
+	{
+		Buckets[Index] = ClassifyEnemy(Inputs, PlayerLocation, Index);
+	}
+}
+
+void EnemyClassification::ClassifyScalar(
+	const FEnemyRangeInputs& Inputs,
+	const FVector& PlayerLocation,
+	TArray<EEnemyRangeBucket>& OutBuckets)
+{
+	const int32 InputsNumber = Inputs.Num();
+	OutBuckets.SetNumUninitialized(InputsNumber, false);
+
+	for (int32 Index = 0; Index < InputsNumber; ++Index)
+	{
+		OutBuckets[Index] = ClassifyEnemy(Inputs, PlayerLocation, Index);
+	}
+}
+
+static void RunEnemyClassificationBenchmark(const TArray<FString>& Args)
+{
+	const int32 EnemiesNumber = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+	const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1000;
+
+	if (EnemiesNumber <= 0 || Iterations <= 0)
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Usage: ap.Benchmark.EnemyClassification [EnemiesNumber] [Iterations]"));
+		return;
+	}
+
+	FRandomStream RandomStream{EnemiesNumber};
+	FEnemyRangeInputs Inputs;
+
+	for (int32 Index = 0; Index < EnemiesNumber; ++Index)
+	{
+		Inputs.Add(
+				   RandomStream.GetUnitVector() * RandomStream.FRandRange(0.f, 4096.f),
+				   RandomStream.FRandRange(512.f, 2048.f),
+				   RandomStream.FRandRange(128.f, 512.f)
+				  );
+	}
+
+	const FVector PlayerLocation{FVector::ZeroVector};
+	TArray<EEnemyRangeBucket> ScalarBuckets;
+	TArray<EEnemyRangeBucket> VectorBuckets;
+
+	double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		EnemyClassification::ClassifyScalar(Inputs, PlayerLocation, ScalarBuckets);
+	}
+
+	const double ScalarTime = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Iterations;
+	StartTime = FPlatformTime::Seconds();
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		EnemyClassification::Classify(Inputs, PlayerLocation, VectorBuckets);
+	}
+
+	const double VectorTime = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Iterations;
+	int32 MismatchesNumber = 0;
+
+	for (int32 Index = 0; Index < EnemiesNumber; ++Index)
+	{
+		MismatchesNumber += ScalarBuckets[Index] != VectorBuckets[Index] ? 1 : 0;
+	}
+
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Enemy classification benchmark: %d enemies, %d iterations, %d mismatches."),
+		   EnemiesNumber,
+		   Iterations,
+		   MismatchesNumber
+		  );
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Scalar: %8.2f us per pass, %.1f enemies per us. Vector: %8.2f us per pass, %.1f enemies per us."),
+		   ScalarTime,
+		   ScalarTime > 0.0 ? EnemiesNumber / ScalarTime : 0.0,
+		   VectorTime,
+		   VectorTime > 0.0 ? EnemiesNumber / VectorTime : 0.0
+		  );
+}
+
+static FAutoConsoleCommand EnemyClassificationBenchmarkCommand(
+	TEXT("ap.Benchmark.EnemyClassification"),
+	TEXT("Compares scalar and vector enemy range classification. Arguments: [EnemiesNumber=10000] [Iterations=1000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunEnemyClassificationBenchmark));
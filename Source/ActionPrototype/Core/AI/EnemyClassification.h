@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Range of the player relative to an enemy's aggro distance and attack radius. */
+enum class EEnemyRangeBucket : uint8
+{
+	OutOfRange,
+	Aggro,
+	Attack
+};
+
+/** Packed positions and radii of enemies, each component is stored in its own array for vector loads. */
+struct FEnemyRangeInputs
+{
+	TArray<float> X{};
+	TArray<float> Y{};
+	TArray<float> Z{};
+	TArray<float> AggroDistances{};
+	TArray<float> AttackRadii{};
+
+	FORCEINLINE int32 Num() const { return X.Num(); }
+
+	void Add(const FVector& Location, const float AggroDistance, const float AttackRadius);
+	void Reset();
+};
+
+namespace EnemyClassification
+{
+	/** Classifies all enemies processing four of them per instruction.
+	 * @param OutBuckets - result array, it's resized to the number of inputs;
+	 */
+	void Classify(const FEnemyRangeInputs& Inputs, const FVector& PlayerLocation, TArray<EEnemyRangeBucket>& OutBuckets);
+
+	/** Reference implementation classifying one enemy at a time. */
+	void ClassifyScalar(
+		const FEnemyRangeInputs& Inputs,
+		const FVector& PlayerLocation,
+		TArray<EEnemyRangeBucket>& OutBuckets);
+}
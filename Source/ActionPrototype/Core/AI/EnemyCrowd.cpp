@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyCrowd.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+int32 FEnemyCrowd::Add(
+	const FTransform& Transform,
+	const EEnemyState State,
+	const float Health,
+	const float AggroDistance,
+	const float AttackRadius,
+	const int32 ClassIndex)
+{
+	Transforms.Add(Transform);
+	States.Add(State);
+	Healths.Add(Health);
+	AggroDistances.Add(AggroDistance);
+	AttackRadii.Add(AttackRadius);
+	ClassIndices.Add(ClassIndex);
+	Actors.AddDefaulted();
+	return DistancesSquared.Add(TNumericLimits<float>::Max());
+}
+
+void FEnemyCrowd::RemoveAtSwap(const int32 Index)
+{
+	Transforms.RemoveAtSwap(Index, 1, false);
+	States.RemoveAtSwap(Index, 1, false);
+	Healths.RemoveAtSwap(Index, 1, false);
+	AggroDistances.RemoveAtSwap(Index, 1, false);
+	AttackRadii.RemoveAtSwap(Index, 1, false);
+	ClassIndices.RemoveAtSwap(Index, 1, false);
+	Actors.RemoveAtSwap(Index, 1, false);
+	DistancesSquared.RemoveAtSwap(Index, 1, false);
+}
+
+void FEnemyCrowd::Reserve(const int32 Number)
+{
+	Transforms.Reserve(Number);
+	States.Reserve(Number);
+	Healths.Reserve(Number);
+	AggroDistances.Reserve(Number);
+	AttackRadii.Reserve(Number);
+	ClassIndices.Reserve(Number);
+	Actors.Reserve(Number);
+	DistancesSquared.Reserve(Number);
+}
+
+void FEnemyCrowd::Empty()
+{
+	Transforms.Empty();
+	States.Empty();
+	Healths.Empty();
+	AggroDistances.Empty();
+	AttackRadii.Empty();
+	ClassIndices.Empty();
+	Actors.Empty();
+	DistancesSquared.Empty();
+}
+
+void FEnemyCrowd::Simulate(
+	const FVector& PlayerLocation,
+	const float DeltaTime,
+	const float MoveSpeed,
+	const int32 TasksNumber)
+{
+	const int32 EntitiesNumber = Num();
+
+	if (EntitiesNumber == 0)
+	{
+		return;
+	}
+
+	const int32 ChunksNumber = FMath::Clamp(TasksNumber, 1, EntitiesNumber);
+	const int32 ChunkSize = FMath::DivideAndRoundUp(EntitiesNumber, ChunksNumber);
+	const EParallelForFlags Flags = ChunksNumber > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+	const float MoveDistance = MoveSpeed * DeltaTime;
+
+	ParallelFor(
+		ChunksNumber,
+		[this, &PlayerLocation, EntitiesNumber, ChunkSize, MoveDistance](const int32 ChunkIndex)
+		{
+			const int32 First = ChunkIndex * ChunkSize;
+			const int32 Last = FMath::Min(First + ChunkSize, EntitiesNumber);
+
+			for (int32 Index = First; Index < Last; ++Index)
+			{
+				FTransform& Transform = Transforms[Index];
+				const FVector Location = Transform.GetLocation();
+				FVector ToPlayer = PlayerLocation - Location;
+				ToPlayer.Z = 0.f;
+				const float DistanceSquared = ToPlayer.SizeSquared();
+				DistancesSquared[Index] = DistanceSquared;
+
+				if (IsPromoted(Index) || Healths[Index] <= 0.f)
+				{
+					continue;
+				}
+
+				EEnemyState& State = States[Index];
+				const float AggroDistanceSquared = FMath::Square(AggroDistances[Index]);
+
+				if (State == EEnemyState::Idle && DistanceSquared < AggroDistanceSquared)
+				{
+					State = EEnemyState::Chase;
+				}
+				else if (State != EEnemyState::Idle && DistanceSquared > AggroDistanceSquared)
+				{
+					State = EEnemyState::Idle;
+				}
+
+				if (State != EEnemyState::Chase)
+				{
+					continue;
+				}
+
+				const float Distance = FMath::Sqrt(DistanceSquared);
+				const float StepDistance = FMath::Min(MoveDistance, Distance - AttackRadii[Index]);
+
+				if (StepDistance <= 0.f)
+				{
+					continue;
+				}
+
+				const FVector Direction = ToPlayer / Distance;
+				Transform.SetLocation(Location + Direction * StepDistance);
+				Transform.SetRotation(Direction.ToOrientationQuat());
+			}
+		},
+		Flags);
+}
+
+void FEnemyCrowd::CollectLodChanges(
+	const float PromoteDistance,
+	const float DemoteDistance,
+	TArray<int32>& OutPromoted,
+	TArray<int32>& OutDemoted) const
+{
+	const float PromoteDistanceSquared = FMath::Square(PromoteDistance);
+	const float DemoteDistanceSquared = FMath::Square(FMath::Max(PromoteDistance, DemoteDistance));
+
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		if (IsPromoted(Index))
+		{
+			if (DistancesSquared[Index] > DemoteDistanceSquared)
+			{
+				OutDemoted.Add(Index);
+			}
+		}
+		else if (DistancesSquared[Index] < PromoteDistanceSquared && Healths[Index] > 0.f)
+		{
+			OutPromoted.Add(Index);
+		}
+	}
+}
+
+static void RunEnemyCrowdBenchmark(const TArray<FString>& Args)
+{
+	const int32 EntitiesNumber = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+	const int32 Frames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 300;
+
+	if (EntitiesNumber <= 0 || Frames <= 0)
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Usage: ap.Benchmark.EnemyCrowd [EntitiesNumber] [Frames]"));
+		return;
+	}
+
+	constexpr float DeltaTime = 1.f / 60.f;
+	constexpr float WorldExtent = 50000.f;
+	FRandomStream RandomStream{EntitiesNumber};
+	FEnemyCrowd Crowd;
+	Crowd.Reserve(EntitiesNumber);
+
+	for (int32 Index = 0; Index < EntitiesNumber; ++Index)
+	{
+		const FVector Location{
+			RandomStream.FRandRange(-WorldExtent, WorldExtent),
+			RandomStream.FRandRange(-WorldExtent, WorldExtent),
+			0.f
+		};
+		Crowd.Add(FTransform{Location}, EEnemyState::Idle, 100.f, 2048.f, 256.f, 0);
+	}
+
+	TArray<int32> Promoted;
+	TArray<int32> Demoted;
+	int32 PromotedTotal = 0;
+	double SimulateTime = 0.0;
+	double LodTime = 0.0;
+
+	for (int32 Frame = 0; Frame < Frames; ++Frame)
+	{
+		const float Angle = 2.f * PI * Frame / Frames;
+		const FVector PlayerLocation{FMath::Cos(Angle) * WorldExtent * 0.5f, FMath::Sin(Angle) * WorldExtent * 0.5f, 0.f};
+
+		double StartTime = FPlatformTime::Seconds();
+		Crowd.Simulate(PlayerLocation, DeltaTime, 300.f, 8);
+		SimulateTime += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		Promoted.Reset();
+		Demoted.Reset();
+		Crowd.CollectLodChanges(4096.f, 6144.f, Promoted, Demoted);
+		LodTime += FPlatformTime::Seconds() - StartTime;
+		PromotedTotal += Promoted.Num();
+	}
+
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Enemy crowd benchmark: %d entities, %d frames, simulation %.2f us, LOD %.2f us per frame, %.1f promotion candidates per frame."),
+		   EntitiesNumber,
+		   Frames,
+		   SimulateTime / Frames * 1000000.0,
+		   LodTime / Frames * 1000000.0,
+		   static_cast<float>(PromotedTotal) / Frames
+		  );
+}
+
+static FAutoConsoleCommand EnemyCrowdBenchmarkCommand(
+	TEXT("ap.Benchmark.EnemyCrowd"),
+	TEXT("Simulates lightweight enemies without a world. Arguments: [EntitiesNumber=10000] [Frames=300]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunEnemyCrowdBenchmark));
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AEnemyCharacter;
+enum class EEnemyState : uint8;
+
+/**
+ * Lightweight representation of enemies stored as parallel arrays of fragments.
+ * Entities are simulated by plain processors and don't touch UObjects, except for promoted entities which are
+ * driven by their AEnemyCharacter actors.
+ */
+struct FEnemyCrowd
+{
+	/** Transform fragment. */
+	TArray<FTransform> Transforms{};
+	/** State fragment. */
+	TArray<EEnemyState> States{};
+	/** Health fragment. */
+	TArray<float> Healths{};
+	TArray<float> AggroDistances{};
+	TArray<float> AttackRadii{};
+	/** Index of the entity class in the owner's class table. */
+	TArray<int32> ClassIndices{};
+	/** Actors of promoted entities, null for lightweight ones. */
+	TArray<TWeakObjectPtr<AEnemyCharacter>> Actors{};
+	/** Squared distance to the player calculated during the last simulation step. */
+	TArray<float> DistancesSquared{};
+
+	FORCEINLINE int32 Num() const { return Transforms.Num(); }
+	FORCEINLINE bool IsPromoted(const int32 Index) const { return !Actors[Index].IsExplicitlyNull(); }
+
+	int32 Add(
+		const FTransform& Transform,
+		const EEnemyState State,
+		const float Health,
+		const float AggroDistance,
+		const float AttackRadius,
+		const int32 ClassIndex);
+	void RemoveAtSwap(const int32 Index);
+	void Reserve(const int32 Number);
+	void Empty();
+
+	/** Runs the state and movement processors on lightweight entities, safe to call from any thread.
+	 * @param MoveSpeed - speed of chasing entities;
+	 * @param TasksNumber - number of parallel tasks entities are split between;
+	 */
+	void Simulate(const FVector& PlayerLocation, const float DeltaTime, const float MoveSpeed, const int32 TasksNumber);
+	/** Collects entities which should be promoted to actors or demoted back to lightweight entities. */
+	void CollectLodChanges(
+		const float PromoteDistance,
+		const float DemoteDistance,
+		TArray<int32>& OutPromoted,
+		TArray<int32>& OutDemoted) const;
+};
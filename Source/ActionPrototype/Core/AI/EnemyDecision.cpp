@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyDecision.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+
+FEnemyCommand EnemyDecision::Decide(const FEnemyDecisionInput& Enemy, const FPlayerDecisionInput& Player)
+{
+	FEnemyCommand Command;
+
+	if (!Player.bIsAlive)
+	{
+		Command.bStopMovement = Enemy.bIsFollowingPath;
+
+		if (Enemy.CurrentState != EEnemyState::Idle)
+		{
+			Command.Action = EEnemyAction::SetIdle;
+		}
+
+		return Command;
+	}
+
+	if (Enemy.RangeBucket == EEnemyRangeBucket::OutOfRange)
+	{
+		return Command;
+	}
+
+	switch (Enemy.CurrentState)
+	{
+		case EEnemyState::Idle:
+			if (!Enemy.bIsPlayerVisible)
+			{
+				break;
+			}
+
+			Command.Action = Enemy.RangeBucket == EEnemyRangeBucket::Attack ? EEnemyAction::Attack : EEnemyAction::Chase;
+			break;
+		case EEnemyState::Chase:
+			if (!Enemy.bIsPlayerVisible)
+			{
+				Command.bStopMovement = Enemy.bIsFollowingPath;
+				Command.Action = EEnemyAction::SetIdle;
+				break;
+			}
+
+			if (Enemy.RangeBucket == EEnemyRangeBucket::Attack)
+			{
+				Command.bStopMovement = Enemy.bIsFollowingPath;
+				Command.Action = EEnemyAction::Attack;
+			}
+			else
+			{
+				Command.Action = EEnemyAction::Chase;
+			}
+			break;
+		case EEnemyState::Attack:
+			if (!Enemy.bIsPlayerVisible)
+			{
+				Command.Action = EEnemyAction::SetIdle;
+			}
+			break;
+		case EEnemyState::Hold:
+			if (!Enemy.bIsPlayerVisible)
+			{
+				Command.Action = EEnemyAction::SetIdle;
+				break;
+			}
+
+			// Attack requests a token again and keeps holding if there is still no free one
+			Command.Action = Enemy.RangeBucket == EEnemyRangeBucket::Attack ? EEnemyAction::Attack : EEnemyAction::Chase;
+			break;
+		default:
+			break;
+	}
+
+	return Command;
+}
+
+void EnemyDecision::DecideAll(
+	const TArray<FEnemyDecisionInput>& Inputs,
+	const FPlayerDecisionInput& Player,
+	TArray<FEnemyCommand>& OutCommands,
+	const int32 TasksNumber)
+{
+	const int32 InputsNumber = Inputs.Num();
+	OutCommands.SetNumUninitialized(InputsNumber, false);
+
+	if (InputsNumber == 0)
+	{
+		return;
+	}
+
+	const int32 ChunksNumber = FMath::Clamp(TasksNumber, 1, InputsNumber);
+	const int32 ChunkSize = FMath::DivideAndRoundUp(InputsNumber, ChunksNumber);
+	const EParallelForFlags Flags = ChunksNumber > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+	ParallelFor(
+		ChunksNumber,
+		[&Inputs, &Player, &OutCommands, InputsNumber, ChunkSize](const int32 ChunkIndex)
+		{
+			const int32 First = ChunkIndex * ChunkSize;
+			const int32 Last = FMath::Min(First + ChunkSize, InputsNumber);
+
+			for (int32 Index = First; Index < Last; ++Index)
+			{
+				OutCommands[Index] = Decide(Inputs[Index], Player);
+			}
+		},
+		Flags);
+}
+
+static void RunEnemyDecisionBenchmark(const TArray<FString>& Args)
+{
+	const int32 EnemiesNumber = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+	const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1000;
+
+	if (EnemiesNumber <= 0 || Iterations <= 0)
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Usage: ap.Benchmark.EnemyDecisions [EnemiesNumber] [Iterations]"));
+		return;
+	}
+
+	FRandomStream RandomStream{EnemiesNumber};
+	FPlayerDecisionInput Player;
+	Player.bIsAlive = true;
+	TArray<FEnemyDecisionInput> Inputs;
+	Inputs.SetNum(EnemiesNumber);
+
+	for (FEnemyDecisionInput& Input : Inputs)
+	{
+		Input.RangeBucket = static_cast<EEnemyRangeBucket>(RandomStream.RandRange(0, 2));
+		Input.CurrentState = static_cast<EEnemyState>(RandomStream.RandRange(0, 2));
+		Input.bIsFollowingPath = RandomStream.FRand() > 0.5f;
+		Input.bIsPlayerVisible = RandomStream.FRand() > 0.25f;
+	}
+
+	TArray<FEnemyCommand> Commands;
+	double SingleTaskTime = 0.0;
+
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Enemy decisions benchmark: %d enemies, %d iterations, %d task graph workers."),
+		   EnemiesNumber,
+		   Iterations,
+		   FTaskGraphInterface::Get().GetNumWorkerThreads()
+		  );
+
+	for (const int32 TasksNumber : {1, 4, 16})
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			EnemyDecision::DecideAll(Inputs, Player, Commands, TasksNumber);
+		}
+
+		const double PassTime = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+		if (TasksNumber == 1)
+		{
+			SingleTaskTime = PassTime;
+		}
+
+		UE_LOG(
+			   LogActionPrototype,
+			   Log,
+			   TEXT("%2d tasks: %8.2f us per pass, speedup %.2fx."),
+			   TasksNumber,
+			   PassTime * 1000000.0,
+			   PassTime > 0.0 ? SingleTaskTime / PassTime : 0.0
+			  );
+	}
+}
+
+static FAutoConsoleCommand EnemyDecisionBenchmarkCommand(
+	TEXT("ap.Benchmark.EnemyDecisions"),
+	TEXT("Measures the enemy decision step on 1, 4 and 16 tasks. Arguments: [EnemiesNumber=1000] [Iterations=1000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunEnemyDecisionBenchmark));
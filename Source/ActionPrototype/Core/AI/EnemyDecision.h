@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyClassification.h"
+
+enum class EEnemyState : uint8;
+
+/** Read-only snapshot of an enemy gathered on the game thread before making decisions. */
+struct FEnemyDecisionInput
+{
+	EEnemyRangeBucket RangeBucket{EEnemyRangeBucket::OutOfRange};
+	EEnemyState CurrentState{};
+	bool bIsFollowingPath{false};
+	bool bIsPlayerVisible{false};
+};
+
+/** Read-only snapshot of the player shared by all enemies' decisions. */
+struct FPlayerDecisionInput
+{
+	FVector Location{FVector::ZeroVector};
+	bool bIsAlive{false};
+};
+
+enum class EEnemyAction : uint8
+{
+	None,
+	SetIdle,
+	Chase,
+	Attack
+};
+
+/** Side effects an enemy has to apply on the game thread. */
+struct FEnemyCommand
+{
+	EEnemyAction Action{EEnemyAction::None};
+	bool bStopMovement{false};
+};
+
+namespace EnemyDecision
+{
+	/** Pure decision step of the enemy state machine, safe to call from any thread. */
+	FEnemyCommand Decide(const FEnemyDecisionInput& Enemy, const FPlayerDecisionInput& Player);
+
+	/** Makes decisions for all inputs splitting them between the given number of parallel tasks.
+	 * @param OutCommands - result array, it's resized to the number of inputs;
+	 */
+	void DecideAll(
+		const TArray<FEnemyDecisionInput>& Inputs,
+		const FPlayerDecisionInput& Player,
+		TArray<FEnemyCommand>& OutCommands,
+		const int32 TasksNumber);
+}
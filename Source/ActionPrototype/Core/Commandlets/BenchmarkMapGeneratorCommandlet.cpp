@@ -0,0 +1,419 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BenchmarkMapGeneratorCommandlet.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Actors/SpawnVolume.h"
+#include "ActionPrototype/Actors/Gameplay/BaseDoor.h"
+#include "ActionPrototype/Actors/Gameplay/FloatingPlatform.h"
+#include "ActionPrototype/Actors/Gameplay/FloorSwitch.h"
+#include "ActionPrototype/Actors/Pickups/PickupCoin.h"
+#include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+#if WITH_EDITOR
+#include "AssetRegistryModule.h"
+#include "BSPOps.h"
+#include "Builders/CubeBuilder.h"
+#include "Components/BrushComponent.h"
+#include "Components/SplineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Polys.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "GameFramework/PlayerStart.h"
+#include "Model.h"
+#include "NavigationSystem.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+#include "UObject/Package.h"
+
+static constexpr float PlatformPathHeight{300.f};
+static constexpr float NavigationBoundsHeight{2000.f};
+
+template <typename T>
+static TSubclassOf<T> ParseClass(const FString& Params, const TCHAR* Name, const TSubclassOf<T> DefaultClass)
+{
+	FString ClassPath;
+
+	if (!FParse::Value(*Params, Name, ClassPath))
+	{
+		return DefaultClass;
+	}
+
+	const TSubclassOf<T> Class = LoadClass<T>(nullptr, *ClassPath);
+
+	if (Class == nullptr)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Benchmark map generator: class %s isn't found, the default one is used."), *ClassPath);
+		return DefaultClass;
+	}
+
+	return Class;
+}
+
+static FActorSpawnParameters GetSpawnParameters()
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return SpawnParameters;
+}
+#endif
+
+UBenchmarkMapGeneratorCommandlet::UBenchmarkMapGeneratorCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBenchmarkMapGeneratorCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString PackageName{TEXT("/Game/Maps/BenchmarkArena")};
+	int32 Seed{0};
+	FBenchmarkMapLayout Layout;
+	FParse::Value(*Params, TEXT("Map="), PackageName);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Doors="), Layout.Doors);
+	FParse::Value(*Params, TEXT("Switches="), Layout.Switches);
+	FParse::Value(*Params, TEXT("Platforms="), Layout.Platforms);
+	FParse::Value(*Params, TEXT("Pickups="), Layout.Pickups);
+	FParse::Value(*Params, TEXT("SpawnVolumes="), Layout.SpawnVolumes);
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	Layout.DoorClass = ParseClass<ABaseDoor>(Params, TEXT("DoorClass="), ABaseDoor::StaticClass());
+	Layout.SwitchClass = ParseClass<AFloorSwitch>(Params, TEXT("SwitchClass="), AFloorSwitch::StaticClass());
+	Layout.PlatformClass = ParseClass<AFloatingPlatform>(Params, TEXT("PlatformClass="), AFloatingPlatform::StaticClass());
+	Layout.PickupClass = ParseClass<ABasePickupItem>(Params, TEXT("PickupClass="), APickupCoin::StaticClass());
+	Layout.EnemyClass = ParseClass<AEnemyCharacter>(Params, TEXT("EnemyClass="), nullptr);
+
+	if (!FPackageName::IsValidLongPackageName(PackageName))
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Benchmark map generator: %s isn't a valid package name."), *PackageName);
+		return 1;
+	}
+
+	if (Layout.Doors < 0 || Layout.Switches < 0 || Layout.Platforms < 0 || Layout.Pickups < 0 || Layout.SpawnVolumes < 0
+		|| CellSize <= 0.f)
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Benchmark map generator: actor counts can't be negative, CellSize must be greater than 0."));
+		return 1;
+	}
+
+	RandomStream.Initialize(Seed);
+
+	// The center cell is kept free for the player start, so the scripted player doesn't spawn inside an actor
+	const int32 CellsNumber = Layout.Doors + Layout.Switches + Layout.Platforms + Layout.Pickups + Layout.SpawnVolumes;
+	const int32 Side = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(CellsNumber + 1)));
+	const int32 CenterCell = Side / 2;
+	const float HalfSize = Side * CellSize * 0.5f;
+	TArray<FVector> Cells;
+	Cells.Reserve(Side * Side);
+
+	for (int32 X = 0; X < Side; ++X)
+	{
+		for (int32 Y = 0; Y < Side; ++Y)
+		{
+			if (X != CenterCell || Y != CenterCell)
+			{
+				Cells.Emplace((X + 0.5f) * CellSize - HalfSize, (Y + 0.5f) * CellSize - HalfSize, 0.f);
+			}
+		}
+	}
+
+	for (int32 Index = Cells.Num() - 1; Index > 0; --Index)
+	{
+		Cells.Swap(Index, RandomStream.RandRange(0, Index));
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	UWorld::InitializationValues InitializationValues;
+	InitializationValues.AllowAudioPlayback(false).RequiresHitProxies(false).CreateNavigation(true).CreateAISystem(false);
+	UWorld* World = UWorld::CreateWorld(
+										EWorldType::Editor,
+										false,
+										FName{*FPackageName::GetShortName(PackageName)},
+										Package,
+										false,
+										ERHIFeatureLevel::Num,
+										&InitializationValues
+									   );
+	World->SetFlags(RF_Public | RF_Standalone);
+
+	const float CenterOffset = (CenterCell + 0.5f) * CellSize - HalfSize;
+	APlayerStart* PlayerStart = World->SpawnActor<APlayerStart>(
+																APlayerStart::StaticClass(),
+																FVector{CenterOffset, CenterOffset, 100.f},
+																FRotator::ZeroRotator,
+																GetSpawnParameters()
+															   );
+	GenerateActors(World, Layout, Cells);
+	SpawnGround(World, HalfSize);
+	BuildNavigation(World, HalfSize);
+	const bool bIsSaved = SaveMap(World, PackageName);
+	World->DestroyWorld(false);
+
+	if (PlayerStart == nullptr || !bIsSaved)
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Benchmark map generator: failed to generate %s."), *PackageName);
+		return 1;
+	}
+
+	UE_LOG(
+		   LogActionPrototype,
+		   Display,
+		   TEXT("Benchmark map generator: %s saved with seed %d, %d doors, %d switches, %d platforms, %d pickups, %d spawn volumes."),
+		   *PackageName,
+		   Seed,
+		   Layout.Doors,
+		   Layout.Switches,
+		   Layout.Platforms,
+		   Layout.Pickups,
+		   Layout.SpawnVolumes
+		  );
+	return 0;
+#else
+	UE_LOG(LogActionPrototype, Error, TEXT("Benchmark map generator can run only in the editor."));
+	return 1;
+#endif
+}
+
+#if WITH_EDITOR
+void UBenchmarkMapGeneratorCommandlet::GenerateActors(
+	UWorld* World,
+	const FBenchmarkMapLayout& Layout,
+	const TArray<FVector>& Cells)
+{
+	const FActorSpawnParameters SpawnParameters = GetSpawnParameters();
+	int32 CellIndex{0};
+	TArray<ABaseDoor*> Doors;
+	Doors.Reserve(Layout.Doors);
+
+	for (int32 Index = 0; Index < Layout.Doors; ++Index)
+	{
+		ABaseDoor* Door = World->SpawnActor<ABaseDoor>(
+													   Layout.DoorClass,
+													   GetPointInCell(Cells[CellIndex++]),
+													   GetRandomYaw(),
+													   SpawnParameters
+													  );
+
+		if (Door != nullptr)
+		{
+			Door->SetActorLabel(FString::Printf(TEXT("Door_%d"), Index));
+			Doors.Add(Door);
+		}
+	}
+
+	// Switches are linked to doors in turn, so every door has a switch while there are enough of them
+	for (int32 Index = 0; Index < Layout.Switches; ++Index)
+	{
+		AFloorSwitch* FloorSwitch = World->SpawnActor<AFloorSwitch>(
+																	Layout.SwitchClass,
+																	GetPointInCell(Cells[CellIndex++]),
+																	GetRandomYaw(),
+																	SpawnParameters
+																   );
+
+		if (FloorSwitch == nullptr)
+		{
+			continue;
+		}
+
+		FloorSwitch->SetActorLabel(FString::Printf(TEXT("FloorSwitch_%d"), Index));
+
+		if (Doors.Num() > 0)
+		{
+			FloorSwitch->AddLinkedDoor(Doors[Index % Doors.Num()]);
+		}
+	}
+
+	for (int32 Index = 0; Index < Layout.Platforms; ++Index)
+	{
+		SpawnPlatform(World, Layout.PlatformClass, Cells[CellIndex++], Index);
+	}
+
+	for (int32 Index = 0; Index < Layout.Pickups; ++Index)
+	{
+		ABasePickupItem* Pickup = World->SpawnActor<ABasePickupItem>(
+																	 Layout.PickupClass,
+																	 GetPointInCell(Cells[CellIndex++]) + FVector{0.f, 0.f, 50.f},
+																	 FRotator::ZeroRotator,
+																	 SpawnParameters
+																	);
+
+		if (Pickup != nullptr)
+		{
+			Pickup->SetActorLabel(FString::Printf(TEXT("Pickup_%d"), Index));
+		}
+	}
+
+	for (int32 Index = 0; Index < Layout.SpawnVolumes; ++Index)
+	{
+		ASpawnVolume* SpawnVolume = World->SpawnActor<ASpawnVolume>(
+																	ASpawnVolume::StaticClass(),
+																	Cells[CellIndex++] + FVector{0.f, 0.f, 100.f},
+																	FRotator::ZeroRotator,
+																	SpawnParameters
+																   );
+
+		if (SpawnVolume == nullptr)
+		{
+			continue;
+		}
+
+		SpawnVolume->SetActorLabel(FString::Printf(TEXT("SpawnVolume_%d"), Index));
+
+		if (Layout.EnemyClass != nullptr)
+		{
+			SpawnVolume->SetCrowdEnemyClass(Layout.EnemyClass);
+		}
+	}
+}
+
+FVector UBenchmarkMapGeneratorCommandlet::GetPointInCell(const FVector& CellOrigin)
+{
+	const float Offset = CellSize * 0.1f;
+	return CellOrigin + FVector{RandomStream.FRandRange(-Offset, Offset), RandomStream.FRandRange(-Offset, Offset), 0.f};
+}
+
+FRotator UBenchmarkMapGeneratorCommandlet::GetRandomYaw()
+{
+	return FRotator{0.f, RandomStream.RandRange(0, 3) * 90.f, 0.f};
+}
+
+AFloatingPlatform* UBenchmarkMapGeneratorCommandlet::SpawnPlatform(
+	UWorld* World,
+	const TSubclassOf<AFloatingPlatform> PlatformClass,
+	const FVector& CellOrigin,
+	const int32 Index)
+{
+	const FActorSpawnParameters SpawnParameters = GetSpawnParameters();
+	const FVector Origin = GetPointInCell(CellOrigin);
+	AActor* SplineActor = World->SpawnActor<AActor>(AActor::StaticClass(), Origin, FRotator::ZeroRotator, SpawnParameters);
+
+	if (SplineActor == nullptr)
+	{
+		return nullptr;
+	}
+
+	USplineComponent* Spline = NewObject<USplineComponent>(SplineActor, TEXT("Spline"), RF_Transactional);
+	Spline->CreationMethod = EComponentCreationMethod::Instance;
+	SplineActor->SetRootComponent(Spline);
+	SplineActor->AddInstanceComponent(Spline);
+	Spline->RegisterComponent();
+	SplineActor->SetActorLocation(Origin);
+	SplineActor->SetActorLabel(FString::Printf(TEXT("PlatformPath_%d"), Index));
+
+	const float Reach = CellSize * 0.35f;
+	const int32 PointsNumber = RandomStream.RandRange(2, 4);
+	Spline->ClearSplinePoints(false);
+	Spline->AddSplinePoint(FVector::ZeroVector, ESplineCoordinateSpace::Local, false);
+
+	for (int32 Point = 1; Point < PointsNumber; ++Point)
+	{
+		const FVector Location{
+			RandomStream.FRandRange(-Reach, Reach),
+			RandomStream.FRandRange(-Reach, Reach),
+			RandomStream.FRandRange(0.f, PlatformPathHeight)
+		};
+		Spline->AddSplinePoint(Location, ESplineCoordinateSpace::Local, false);
+	}
+
+	Spline->UpdateSpline();
+
+	AFloatingPlatform* Platform = World->SpawnActor<AFloatingPlatform>(
+																	   PlatformClass,
+																	   Origin,
+																	   FRotator::ZeroRotator,
+																	   SpawnParameters
+																	  );
+
+	if (Platform == nullptr)
+	{
+		return nullptr;
+	}
+
+	Platform->SetActorLabel(FString::Printf(TEXT("FloatingPlatform_%d"), Index));
+	Platform->SetActorWithSpline(SplineActor);
+	Platform->SetMovementMode(EFloatingPlatformMode::Loop, true);
+	return Platform;
+}
+
+void UBenchmarkMapGeneratorCommandlet::SpawnGround(UWorld* World, const float HalfSize) const
+{
+	UStaticMesh* PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+	AStaticMeshActor* Ground = World->SpawnActor<AStaticMeshActor>(
+																   AStaticMeshActor::StaticClass(),
+																   FVector::ZeroVector,
+																   FRotator::ZeroRotator,
+																   GetSpawnParameters()
+																  );
+
+	if (Ground == nullptr || PlaneMesh == nullptr)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Benchmark map generator: failed to spawn the ground."));
+		return;
+	}
+
+	// The plane mesh is 100 units wide
+	Ground->SetActorLabel(TEXT("Ground"));
+	Ground->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+	Ground->SetActorScale3D(FVector{HalfSize / 50.f, HalfSize / 50.f, 1.f});
+}
+
+void UBenchmarkMapGeneratorCommandlet::BuildNavigation(UWorld* World, const float HalfSize) const
+{
+	ANavMeshBoundsVolume* NavigationBounds = World->SpawnActor<ANavMeshBoundsVolume>(
+																					 ANavMeshBoundsVolume::StaticClass(),
+																					 FVector::ZeroVector,
+																					 FRotator::ZeroRotator,
+																					 GetSpawnParameters()
+																					);
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+
+	if (NavigationBounds == nullptr || NavigationSystem == nullptr)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Benchmark map generator: navigation isn't built."));
+		return;
+	}
+
+	// Volumes keep their shape in a brush, built the same way the editor builds it for placed volumes
+	UCubeBuilder* CubeBuilder = NewObject<UCubeBuilder>(NavigationBounds);
+	CubeBuilder->X = HalfSize * 2.f;
+	CubeBuilder->Y = HalfSize * 2.f;
+	CubeBuilder->Z = NavigationBoundsHeight;
+	NavigationBounds->PreEditChange(nullptr);
+	NavigationBounds->PolyFlags = 0;
+	NavigationBounds->Brush = NewObject<UModel>(NavigationBounds, NAME_None, RF_Transactional);
+	NavigationBounds->Brush->Initialize(nullptr, true);
+	NavigationBounds->Brush->Polys = NewObject<UPolys>(NavigationBounds->Brush, NAME_None, RF_Transactional);
+	NavigationBounds->GetBrushComponent()->Brush = NavigationBounds->Brush;
+	NavigationBounds->BrushBuilder = CubeBuilder;
+	CubeBuilder->Build(World, NavigationBounds);
+	FBSPOps::csgPrepMovingBrush(NavigationBounds);
+	NavigationBounds->PostEditChange();
+	NavigationBounds->SetActorLabel(TEXT("NavigationBounds"));
+
+	NavigationSystem->OnNavigationBoundsUpdated(NavigationBounds);
+	NavigationSystem->Build();
+}
+
+bool UBenchmarkMapGeneratorCommandlet::SaveMap(UWorld* World, const FString& PackageName) const
+{
+	UPackage* Package = World->GetOutermost();
+	const FString FileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetMapPackageExtension());
+	FAssetRegistryModule::AssetCreated(World);
+	Package->MarkPackageDirty();
+
+	if (!UPackage::SavePackage(Package, World, RF_NoFlags, *FileName, GError, nullptr, false, true, SAVE_NoError))
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Benchmark map generator: failed to save %s."), *FileName);
+		return false;
+	}
+
+	return true;
+}
+#endif
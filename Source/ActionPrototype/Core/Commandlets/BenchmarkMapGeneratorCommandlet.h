@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BenchmarkMapGeneratorCommandlet.generated.h"
+
+class ABaseDoor;
+class ABasePickupItem;
+class AEnemyCharacter;
+class AFloatingPlatform;
+class AFloorSwitch;
+class ASpawnVolume;
+class UWorld;
+
+/** Number and classes of actors placed by the generator. */
+struct FBenchmarkMapLayout
+{
+	int32 Doors{200};
+	int32 Switches{200};
+	int32 Platforms{100};
+	int32 Pickups{300};
+	int32 SpawnVolumes{8};
+	TSubclassOf<ABaseDoor> DoorClass{nullptr};
+	TSubclassOf<AFloorSwitch> SwitchClass{nullptr};
+	TSubclassOf<AFloatingPlatform> PlatformClass{nullptr};
+	TSubclassOf<ABasePickupItem> PickupClass{nullptr};
+	TSubclassOf<AEnemyCharacter> EnemyClass{nullptr};
+};
+
+/**
+ * Generates a benchmark map with doors, floor switches opening them, floating platforms moving along generated
+ * splines, pickups and spawn volumes, laid out on a grid around a player start. The same seed gives the same map.
+ * Needs the editor:
+ *
+ * UE4Editor-Cmd <Project> -run=BenchmarkMapGenerator -Map=/Game/Maps/BenchmarkArena -Seed=0 [-Doors=200]
+ *     [-Switches=200] [-Platforms=100] [-Pickups=300] [-SpawnVolumes=8] [-CellSize=800]
+ *     [-DoorClass=<Class Path>] [-SwitchClass=<Class Path>] [-PlatformClass=<Class Path>]
+ *     [-PickupClass=<Class Path>] [-EnemyClass=<Class Path>]
+ *
+ * The map is then run with -run=CombatBenchmark -Map=<Same Map>.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API UBenchmarkMapGeneratorCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBenchmarkMapGeneratorCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+#if WITH_EDITOR
+private:
+	FRandomStream RandomStream{};
+	float CellSize{800.f};
+
+	void GenerateActors(UWorld* World, const FBenchmarkMapLayout& Layout, const TArray<FVector>& Cells);
+	/** Returns a random point of the cell, far enough from its borders to not overlap the neighbours. */
+	FVector GetPointInCell(const FVector& CellOrigin);
+	FRotator GetRandomYaw();
+	/** Spawns a spline holder with random points around the cell and a platform moving along it. */
+	AFloatingPlatform* SpawnPlatform(
+		UWorld* World,
+		const TSubclassOf<AFloatingPlatform> PlatformClass,
+		const FVector& CellOrigin,
+		const int32 Index);
+
+	void SpawnGround(UWorld* World, const float HalfSize) const;
+	/** Places navigation bounds over the ground and builds the navmesh, so enemies move without runtime generation. */
+	void BuildNavigation(UWorld* World, const float HalfSize) const;
+	bool SaveMap(UWorld* World, const FString& PackageName) const;
+#endif
+};
@@ -0,0 +1,565 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CombatBenchmarkCommandlet.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Actors/SpawnVolume.h"
+#include "ActionPrototype/Characters/BaseCharacter.h"
+#include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "ActionPrototype/Core/Subsystems/GameplayMemorySubsystem.h"
+#include "ActionPrototype/Core/Subsystems/RandomSeedSubsystem.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Tickable.h"
+
+static constexpr float ScriptedPathRadius{800.f};
+/** Radians per second, a lap takes about 12 seconds. */
+static constexpr float ScriptedAngularSpeed{0.5f};
+
+/** Returns e.g. CombatFrameMs for the Combat gameplay budget category. */
+static FString GetCategoryMetricName(const int32 Category)
+{
+	return StaticEnum<EGameplayBudget>()->GetNameStringByValue(Category) + TEXT("FrameMs");
+}
+
+UCombatBenchmarkCommandlet::UCombatBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCombatBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString BaselinePath;
+	FString ResultsPath;
+
+	if (FParse::Value(*Params, TEXT("Baseline="), BaselinePath) && FParse::Value(*Params, TEXT("Results="), ResultsPath))
+	{
+		float Threshold{10.f};
+		FParse::Value(*Params, TEXT("Threshold="), Threshold);
+		return CompareResults(BaselinePath, ResultsPath, Threshold);
+	}
+
+	return RunBenchmark(Params);
+}
+
+int32 UCombatBenchmarkCommandlet::RunBenchmark(const FString& Params)
+{
+	FString MapName{TEXT("/Game/Maps/BenchmarkArena")};
+	int32 EnemiesNumber{100};
+	float Seconds{30.f};
+	float Step{1.f / 30.f};
+	FString EnemyClassPath;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(
+		 TEXT("CombatBenchmark_%s"),
+		 *FDateTime::Now().ToString()
+		);
+	FParse::Value(*Params, TEXT("Map="), MapName);
+	FParse::Value(*Params, TEXT("Enemies="), EnemiesNumber);
+	FParse::Value(*Params, TEXT("Seconds="), Seconds);
+	FParse::Value(*Params, TEXT("Step="), Step);
+	FParse::Value(*Params, TEXT("EnemyClass="), EnemyClassPath);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	int32 GarbageCollectionFrames = FMath::Max(FMath::RoundToInt(GEngine->TimeBetweenPurgingPendingKillObjects / Step), 1);
+	FParse::Value(*Params, TEXT("GCFrames="), GarbageCollectionFrames);
+
+	if (Step <= 0.f || Seconds <= 0.f || EnemiesNumber < 0 || GarbageCollectionFrames <= 0)
+	{
+		UE_LOG(
+			   LogActionPrototype,
+			   Error,
+			   TEXT("Combat benchmark: Step, Seconds and GCFrames must be greater than 0, Enemies can't be negative.")
+			  );
+		return 1;
+	}
+
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+	FWorldContext* WorldContext = GameInstance->GetWorldContext();
+	FString Error;
+
+	if (!GEngine->LoadMap(*WorldContext, FURL{nullptr, *MapName, TRAVEL_Absolute}, nullptr, Error))
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Combat benchmark: failed to load %s. %s"), *MapName, *Error);
+		GameInstance->RemoveFromRoot();
+		return 1;
+	}
+
+	UWorld* World = WorldContext->World();
+	const TSubclassOf<AEnemyCharacter> EnemyClass = EnemyClassPath.IsEmpty()
+		                                                ? nullptr
+		                                                : LoadClass<AEnemyCharacter>(nullptr, *EnemyClassPath);
+	APawn* Player = SpawnScriptedPlayer(World);
+	const int32 SpawnedNumber = SpawnEnemies(World, EnemyClass, EnemiesNumber);
+
+	if (Player == nullptr)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Combat benchmark: no player was spawned, enemies stay idle."));
+	}
+
+	const FDelegateHandle PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(
+		 this,
+		 &UCombatBenchmarkCommandlet::HandlePreGarbageCollect
+		);
+	const FDelegateHandle PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(
+		 this,
+		 &UCombatBenchmarkCommandlet::HandlePostGarbageCollect
+		);
+
+	const int32 FramesNumber = FMath::CeilToInt(Seconds / Step);
+	const FVector Origin = Player != nullptr ? Player->GetActorLocation() : FVector::ZeroVector;
+	Frames.Reset(FramesNumber);
+	GarbageCollectionsNumber = 0;
+	GarbageCollectionTotalMs = 0.0;
+	UE_LOG(
+		   LogActionPrototype,
+		   Display,
+		   TEXT("Combat benchmark: %s, %d of %d enemies spawned, simulating %d frames of %.4f s."),
+		   *MapName,
+		   SpawnedNumber,
+		   EnemiesNumber,
+		   FramesNumber,
+		   Step
+		  );
+
+	// Classes are sampled after the spawn wave and then about every simulated second to catch the peaks
+	UGameplayMemorySubsystem* GameplayMemory = World->GetSubsystem<UGameplayMemorySubsystem>();
+	const int32 MemorySampleFrames = FMath::Max(FMath::RoundToInt(1.f / Step), 1);
+
+	for (int32 Frame = 0; Frame < FramesNumber; ++Frame)
+	{
+		if (Player != nullptr)
+		{
+			DriveScriptedPlayer(Player, Origin, Frame * Step);
+		}
+
+		if (GameplayMemory != nullptr && Frame % MemorySampleFrames == 0)
+		{
+			GameplayMemory->SampleClasses();
+		}
+
+		// Collected on a fixed frame rather than by wall-clock time, so slower runs don't collect more often
+		const bool bCollectGarbage = (Frame + 1) % GarbageCollectionFrames == 0;
+		Frames.Add(SimulateFrame(World, Step, bCollectGarbage));
+	}
+
+	if (GameplayMemory != nullptr)
+	{
+		GameplayMemory->SampleClasses();
+		MemorySummary = MakeMemorySummary(*GameplayMemory);
+	}
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	const URandomSeedSubsystem* RandomSeed = World->GetSubsystem<URandomSeedSubsystem>();
+	const UGameplayBudgetSubsystem* GameplayBudget = World->GetSubsystem<UGameplayBudgetSubsystem>();
+	GameplayHitchesNumber = GameplayBudget != nullptr ? GameplayBudget->GetHitchesNumber() : 0;
+	const bool bIsWritten = WriteCsv(OutputPath + TEXT(".csv")) && WriteJson(
+																			 OutputPath + TEXT(".json"),
+																			 MapName,
+																			 EnemiesNumber,
+																			 Step,
+																			 RandomSeed != nullptr ? RandomSeed->GetWorldSeed() : 0
+																			);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GameInstance->RemoveFromRoot();
+	CollectGarbage(RF_NoFlags);
+
+	if (!bIsWritten)
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Combat benchmark: failed to write results to %s."), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogActionPrototype, Display, TEXT("Combat benchmark: results are written to %s.csv and .json."), *OutputPath);
+	return 0;
+}
+
+int32 UCombatBenchmarkCommandlet::CompareResults(
+	const FString& BaselinePath,
+	const FString& ResultsPath,
+	const float Threshold) const
+{
+	TSharedPtr<FJsonObject> Summaries[2];
+	const FString Paths[2]{BaselinePath, ResultsPath};
+
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		FString Json;
+
+		if (!FFileHelper::LoadFileToString(Json, *Paths[Index])
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Summaries[Index])
+			|| !Summaries[Index].IsValid())
+		{
+			UE_LOG(LogActionPrototype, Error, TEXT("Combat benchmark: failed to read %s."), *Paths[Index]);
+			return 1;
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* BaselineMetrics{nullptr};
+	const TSharedPtr<FJsonObject>* ResultsMetrics{nullptr};
+
+	if (!Summaries[0]->TryGetObjectField(TEXT("Metrics"), BaselineMetrics)
+		|| !Summaries[1]->TryGetObjectField(TEXT("Metrics"), ResultsMetrics))
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Combat benchmark: summaries have no metrics."));
+		return 1;
+	}
+
+	int32 RegressionsNumber{0};
+	UE_LOG(LogActionPrototype, Display, TEXT("%-24s %12s %12s %9s"), TEXT("Metric"), TEXT("Baseline"), TEXT("Results"), TEXT("Delta"));
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Metric : (*BaselineMetrics)->Values)
+	{
+		const TSharedPtr<FJsonObject>* ResultsMetric{nullptr};
+
+		if (!(*ResultsMetrics)->TryGetObjectField(Metric.Key, ResultsMetric))
+		{
+			continue;
+		}
+
+		for (const TCHAR* Field : {TEXT("Avg"), TEXT("P95")})
+		{
+			const double BaselineValue = Metric.Value->AsObject()->GetNumberField(Field);
+			const double ResultsValue = (*ResultsMetric)->GetNumberField(Field);
+			const double Delta = BaselineValue > 0.0 ? (ResultsValue - BaselineValue) / BaselineValue * 100.0 : 0.0;
+			// Only timings are regressions, counters and memory are reported for context
+			const bool bIsRegression = Metric.Key.EndsWith(TEXT("Ms")) && Delta > Threshold;
+			RegressionsNumber += bIsRegression ? 1 : 0;
+			UE_LOG(
+				   LogActionPrototype,
+				   Display,
+				   TEXT("%-24s %12.3f %12.3f %+8.1f%%%s"),
+				   *FString::Printf(TEXT("%s %s"), *Metric.Key, Field),
+				   BaselineValue,
+				   ResultsValue,
+				   Delta,
+				   bIsRegression ? TEXT(" REGRESSION") : TEXT("")
+				  );
+		}
+	}
+
+	if (RegressionsNumber > 0)
+	{
+		UE_LOG(LogActionPrototype, Error, TEXT("Combat benchmark: %d timings regressed over %.1f%%."), RegressionsNumber, Threshold);
+		return 1;
+	}
+
+	return 0;
+}
+
+int32 UCombatBenchmarkCommandlet::SpawnEnemies(
+	UWorld* World,
+	TSubclassOf<AEnemyCharacter> EnemyClass,
+	const int32 EnemiesNumber) const
+{
+	TArray<ASpawnVolume*> SpawnVolumes;
+
+	for (ASpawnVolume* SpawnVolume : TActorRange<ASpawnVolume>(World))
+	{
+		SpawnVolumes.Add(SpawnVolume);
+	}
+
+	if (SpawnVolumes.Num() == 0)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Combat benchmark: the map has no spawn volumes."));
+		return 0;
+	}
+
+	int32 SpawnedNumber{0};
+
+	for (int32 Index = 0; Index < SpawnVolumes.Num(); ++Index)
+	{
+		ASpawnVolume* SpawnVolume = SpawnVolumes[Index];
+		const int32 VolumeEnemiesNumber = EnemiesNumber / SpawnVolumes.Num() + (Index < EnemiesNumber % SpawnVolumes.Num() ? 1 : 0);
+		const TSubclassOf<AEnemyCharacter> VolumeEnemyClass = EnemyClass != nullptr ? EnemyClass : SpawnVolume->GetCrowdEnemyClass();
+		SpawnedNumber += SpawnVolume->SpawnEnemies(VolumeEnemyClass, VolumeEnemiesNumber);
+	}
+
+	return SpawnedNumber;
+}
+
+APawn* UCombatBenchmarkCommandlet::SpawnScriptedPlayer(UWorld* World) const
+{
+	AGameModeBase* GameMode = World->GetAuthGameMode();
+
+	if (GameMode == nullptr)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APlayerController* Controller = World->SpawnActor<APlayerController>(
+																		 GameMode->PlayerControllerClass,
+																		 FVector::ZeroVector,
+																		 FRotator::ZeroRotator,
+																		 SpawnParameters
+																		);
+
+	if (Controller == nullptr)
+	{
+		return nullptr;
+	}
+
+	GameMode->RestartPlayer(Controller);
+	APawn* Player = Controller->GetPawn();
+	ABaseCharacter* Character = Cast<ABaseCharacter>(Player);
+
+	if (Character != nullptr)
+	{
+		// The player has to survive the whole run, so every frame has the same amount of combat
+		Character->bIsInvulnerable = true;
+	}
+
+	return Player;
+}
+
+void UCombatBenchmarkCommandlet::DriveScriptedPlayer(APawn* Player, const FVector& Origin, const float Time) const
+{
+	const float Angle = Time * ScriptedAngularSpeed;
+	const FVector Target = Origin + FVector{FMath::Cos(Angle), FMath::Sin(Angle), 0.f} * ScriptedPathRadius;
+	Player->AddMovementInput((Target - Player->GetActorLocation()).GetSafeNormal2D());
+}
+
+FCombatBenchmarkFrame UCombatBenchmarkCommandlet::SimulateFrame(UWorld* World, const float Step, const bool bCollectGarbage)
+{
+	FCombatBenchmarkFrame Frame;
+	FApp::SetDeltaTime(Step);
+	FApp::SetCurrentTime(FApp::GetCurrentTime() + Step);
+
+	const double FrameStartTime = FPlatformTime::Seconds();
+	double PhaseStartTime = FrameStartTime;
+	auto FinishPhase = [&PhaseStartTime]()
+	{
+		const double Time = FPlatformTime::Seconds();
+		const float Milliseconds = static_cast<float>((Time - PhaseStartTime) * 1000.0);
+		PhaseStartTime = Time;
+		return Milliseconds;
+	};
+
+	World->Tick(LEVELTICK_All, Step);
+	Frame.WorldTickMs = FinishPhase();
+	FTickableGameObject::TickObjects(World, LEVELTICK_All, false, Step);
+	Frame.TickablesMs = FinishPhase();
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	Frame.GameThreadTasksMs = FinishPhase();
+
+	if (bCollectGarbage)
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	Frame.GarbageCollectionMs = FinishPhase();
+	Frame.FrameMs = static_cast<float>((PhaseStartTime - FrameStartTime) * 1000.0);
+	++GFrameCounter;
+	// The engine loop doesn't run in commandlets, frame end listeners such as the gameplay budgets are notified here
+	FCoreDelegates::OnEndFrame.Broadcast();
+	const UGameplayBudgetSubsystem* GameplayBudget = World->GetSubsystem<UGameplayBudgetSubsystem>();
+
+	if (GameplayBudget != nullptr)
+	{
+		for (int32 Index = 0; Index < static_cast<int32>(EGameplayBudget::Max); ++Index)
+		{
+			Frame.CategoryFrameMs[Index] = GameplayBudget->GetLastFrameMs(static_cast<EGameplayBudget>(Index));
+		}
+	}
+
+	Frame.UsedMemoryMB = static_cast<float>(FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0));
+	Frame.Objects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+	for (TActorIterator<AEnemyCharacter> It{World}; It; ++It)
+	{
+		++Frame.Enemies;
+	}
+
+	return Frame;
+}
+
+bool UCombatBenchmarkCommandlet::WriteCsv(const FString& Path) const
+{
+	FString Csv{TEXT("Frame,FrameMs,WorldTickMs,TickablesMs,GameThreadTasksMs,GarbageCollectionMs,UsedMemoryMB,Enemies,Objects")};
+
+	for (int32 Category = 0; Category < static_cast<int32>(EGameplayBudget::Max); ++Category)
+	{
+		Csv += TEXT(",") + GetCategoryMetricName(Category);
+	}
+
+	Csv += TEXT("\n");
+
+	for (int32 Index = 0; Index < Frames.Num(); ++Index)
+	{
+		const FCombatBenchmarkFrame& Frame = Frames[Index];
+		Csv += FString::Printf(
+							   TEXT("%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f,%d,%d"),
+							   Index,
+							   Frame.FrameMs,
+							   Frame.WorldTickMs,
+							   Frame.TickablesMs,
+							   Frame.GameThreadTasksMs,
+							   Frame.GarbageCollectionMs,
+							   Frame.UsedMemoryMB,
+							   Frame.Enemies,
+							   Frame.Objects
+							  );
+
+		for (const float CategoryMs : Frame.CategoryFrameMs)
+		{
+			Csv += FString::Printf(TEXT(",%.4f"), CategoryMs);
+		}
+
+		Csv += TEXT("\n");
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+bool UCombatBenchmarkCommandlet::WriteJson(
+	const FString& Path,
+	const FString& MapName,
+	const int32 EnemiesNumber,
+	const float Step,
+	const int32 Seed) const
+{
+	const TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	Summary->SetStringField(TEXT("Map"), MapName);
+	Summary->SetNumberField(TEXT("Enemies"), EnemiesNumber);
+	Summary->SetNumberField(TEXT("Step"), Step);
+	Summary->SetNumberField(TEXT("Seed"), Seed);
+	Summary->SetNumberField(TEXT("Frames"), Frames.Num());
+	Summary->SetNumberField(TEXT("GarbageCollections"), GarbageCollectionsNumber);
+	Summary->SetNumberField(TEXT("GarbageCollectionTotalMs"), GarbageCollectionTotalMs);
+	Summary->SetNumberField(TEXT("GameplayHitches"), GameplayHitchesNumber);
+
+	if (MemorySummary.IsValid())
+	{
+		Summary->SetObjectField(TEXT("Memory"), MemorySummary);
+	}
+
+	TArray<float> Values;
+	Values.Reserve(Frames.Num());
+	const TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+	auto AddFrameMetric = [this, &Values, &Metrics](const TCHAR* Name, TFunctionRef<float(const FCombatBenchmarkFrame&)> Getter)
+	{
+		Values.Reset();
+
+		for (const FCombatBenchmarkFrame& Frame : Frames)
+		{
+			Values.Add(Getter(Frame));
+		}
+
+		AddMetric(*Metrics, Name, Values);
+	};
+
+	AddFrameMetric(TEXT("FrameMs"), [](const FCombatBenchmarkFrame& Frame) { return Frame.FrameMs; });
+	AddFrameMetric(TEXT("WorldTickMs"), [](const FCombatBenchmarkFrame& Frame) { return Frame.WorldTickMs; });
+	AddFrameMetric(TEXT("TickablesMs"), [](const FCombatBenchmarkFrame& Frame) { return Frame.TickablesMs; });
+	AddFrameMetric(TEXT("GameThreadTasksMs"), [](const FCombatBenchmarkFrame& Frame) { return Frame.GameThreadTasksMs; });
+	AddFrameMetric(TEXT("GarbageCollectionMs"), [](const FCombatBenchmarkFrame& Frame) { return Frame.GarbageCollectionMs; });
+	AddFrameMetric(TEXT("UsedMemoryMB"), [](const FCombatBenchmarkFrame& Frame) { return Frame.UsedMemoryMB; });
+	AddFrameMetric(TEXT("Enemies"), [](const FCombatBenchmarkFrame& Frame) { return static_cast<float>(Frame.Enemies); });
+	AddFrameMetric(TEXT("Objects"), [](const FCombatBenchmarkFrame& Frame) { return static_cast<float>(Frame.Objects); });
+
+	// Named with the Ms suffix, so the comparison with a baseline checks them for regressions like the other timings
+	for (int32 Category = 0; Category < static_cast<int32>(EGameplayBudget::Max); ++Category)
+	{
+		AddFrameMetric(
+					   *GetCategoryMetricName(Category),
+					   [Category](const FCombatBenchmarkFrame& Frame) { return Frame.CategoryFrameMs[Category]; }
+					  );
+	}
+
+	Summary->SetObjectField(TEXT("Metrics"), Metrics);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	return FJsonSerializer::Serialize(Summary, Writer) && FFileHelper::SaveStringToFile(Json, *Path);
+}
+
+TSharedRef<FJsonObject> UCombatBenchmarkCommandlet::MakeMemorySummary(const UGameplayMemorySubsystem& GameplayMemory)
+{
+	TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Classes;
+
+	for (const FGameplayMemoryClassEntry& Entry : GameplayMemory.GetClassEntries())
+	{
+		TSharedRef<FJsonObject> Class = MakeShared<FJsonObject>();
+		Class->SetStringField(TEXT("Class"), Entry.ClassName.ToString());
+		Class->SetNumberField(TEXT("Instances"), Entry.Instances);
+		Class->SetNumberField(TEXT("PeakInstances"), Entry.PeakInstances);
+		Class->SetNumberField(TEXT("KB"), Entry.Bytes / 1024.0);
+		Class->SetNumberField(TEXT("PeakKB"), Entry.PeakBytes / 1024.0);
+		Classes.Add(MakeShared<FJsonValueObject>(Class));
+	}
+
+	Memory->SetArrayField(TEXT("Classes"), Classes);
+	TSharedRef<FJsonObject> Tags = MakeShared<FJsonObject>();
+
+	for (int32 Index = 0; Index < static_cast<int32>(EActionPrototypeLLMTag::Max); ++Index)
+	{
+		const EActionPrototypeLLMTag Tag = static_cast<EActionPrototypeLLMTag>(Index);
+		TSharedRef<FJsonObject> TagObject = MakeShared<FJsonObject>();
+		TagObject->SetNumberField(TEXT("MB"), GameplayMemory.GetTagBytes(Tag) / (1024.0 * 1024.0));
+		TagObject->SetNumberField(TEXT("PeakMB"), GameplayMemory.GetTagPeakBytes(Tag) / (1024.0 * 1024.0));
+		Tags->SetObjectField(UGameplayMemorySubsystem::GetTagName(Tag), TagObject);
+	}
+
+	// Tags stay at zero unless the benchmark runs with -llm
+	Memory->SetObjectField(TEXT("LLMTags"), Tags);
+	return Memory;
+}
+
+void UCombatBenchmarkCommandlet::AddMetric(FJsonObject& Object, const FString& Name, TArray<float> Values)
+{
+	const TSharedRef<FJsonObject> Metric = MakeShared<FJsonObject>();
+
+	if (Values.Num() > 0)
+	{
+		Values.Sort();
+		double Sum{0.0};
+
+		for (const float Value : Values)
+		{
+			Sum += Value;
+		}
+
+		Metric->SetNumberField(TEXT("Avg"), Sum / Values.Num());
+		Metric->SetNumberField(TEXT("P50"), Values[Values.Num() / 2]);
+		Metric->SetNumberField(TEXT("P95"), Values[FMath::Min(Values.Num() * 95 / 100, Values.Num() - 1)]);
+		Metric->SetNumberField(TEXT("Max"), Values.Last());
+	}
+
+	Object.SetObjectField(Name, Metric);
+}
+
+void UCombatBenchmarkCommandlet::HandlePreGarbageCollect()
+{
+	GarbageCollectionStartTime = FPlatformTime::Seconds();
+}
+
+void UCombatBenchmarkCommandlet::HandlePostGarbageCollect()
+{
+	++GarbageCollectionsNumber;
+	GarbageCollectionTotalMs += (FPlatformTime::Seconds() - GarbageCollectionStartTime) * 1000.0;
+}
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatBenchmarkCommandlet.generated.h"
+
+class AEnemyCharacter;
+class APawn;
+class FJsonObject;
+class UGameplayMemorySubsystem;
+class UWorld;
+
+/** Timings and counters of a single simulated frame. */
+struct FCombatBenchmarkFrame
+{
+	float FrameMs{0.f};
+	float WorldTickMs{0.f};
+	float TickablesMs{0.f};
+	float GameThreadTasksMs{0.f};
+	float GarbageCollectionMs{0.f};
+	/** Time of each gameplay budget category, see UGameplayBudgetSubsystem. */
+	float CategoryFrameMs[static_cast<int32>(EGameplayBudget::Max)]{};
+	float UsedMemoryMB{0.f};
+	int32 Enemies{0};
+	int32 Objects{0};
+};
+
+/**
+ * Loads an arena, spawns enemies through its spawn volumes, drives a scripted player and simulates the world
+ * with a fixed step. Per frame timings are written to CSV and a summary to JSON. Runs headless:
+ *
+ * UE4Editor-Cmd <Project> -run=CombatBenchmark -nullrhi -Map=/Game/Maps/BenchmarkArena -Enemies=200 -Seconds=60
+ *     [-Step=0.0333] [-EnemyClass=<Class Path>] [-Output=<Path Without Extension>] [-APSeed=<Number>]
+ *     [-GCFrames=<Number>]
+ *
+ * Garbage is collected every GCFrames simulated frames, by default the engine's purge interval in simulated time.
+ *
+ * Two summaries are compared with -Baseline=<Json> -Results=<Json> [-Threshold=<Percent>], the commandlet fails if
+ * a timing regresses over the threshold.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API UCombatBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCombatBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 RunBenchmark(const FString& Params);
+	int32 CompareResults(const FString& BaselinePath, const FString& ResultsPath, const float Threshold) const;
+
+	/** Spawns the requested number of enemies spread between the spawn volumes of the world. */
+	int32 SpawnEnemies(UWorld* World, TSubclassOf<AEnemyCharacter> EnemyClass, const int32 EnemiesNumber) const;
+	APawn* SpawnScriptedPlayer(UWorld* World) const;
+	/** Walks the player around its start point, so enemies wake up, chase and attack it. */
+	void DriveScriptedPlayer(APawn* Player, const FVector& Origin, const float Time) const;
+	FCombatBenchmarkFrame SimulateFrame(UWorld* World, const float Step, const bool bCollectGarbage);
+
+	bool WriteCsv(const FString& Path) const;
+	bool WriteJson(
+		const FString& Path,
+		const FString& MapName,
+		const int32 EnemiesNumber,
+		const float Step,
+		const int32 Seed) const;
+	static void AddMetric(FJsonObject& Object, const FString& Name, TArray<float> Values);
+	/** Instances and memory of gameplay classes with their peaks and the gameplay LLM tags. */
+	static TSharedRef<FJsonObject> MakeMemorySummary(const UGameplayMemorySubsystem& GameplayMemory);
+
+	TArray<FCombatBenchmarkFrame> Frames{};
+	int32 GarbageCollectionsNumber{0};
+	double GarbageCollectionStartTime{0.0};
+	double GarbageCollectionTotalMs{0.0};
+	/** Frames over a gameplay budget, see UGameplayBudgetSubsystem. */
+	int32 GameplayHitchesNumber{0};
+	TSharedPtr<FJsonObject> MemorySummary{};
+
+	void HandlePreGarbageCollect();
+	void HandlePostGarbageCollect();
+};
@@ -3,18 +3,58 @@
 
 #include "ActionPlayerController.h"
 
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/PlayerCharacter.h"
+#include "ActionPrototype/Core/UI/ActionHUDWidget.h"
+#include "ActionPrototype/Core/UI/PlayerHUDViewModel.h"
 #include "Blueprint/UserWidget.h"
 
 void AActionPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
+	AP_LLM_SCOPE(HUD);
+	UPlayerHUDViewModel* ViewModel = GetOrCreateHUDViewModel();
+	ViewModel->SetCharacter(Cast<APlayerCharacter>(GetPawn()));
+
 	if (PlayerHUDClass != nullptr)
 	{
 		PlayerHUD = CreateWidget<UUserWidget>(this, PlayerHUDClass);
 		PlayerHUD->AddToViewport();
-		PlayerHUD->SetVisibility(ESlateVisibility::Visible);
+		PlayerHUD->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+
+		UActionHUDWidget* ActionHUD = Cast<UActionHUDWidget>(PlayerHUD);
+
+		if (ActionHUD != nullptr)
+		{
+			ActionHUD->SetViewModel(ViewModel);
+		}
+	}
+}
+
+void AActionPlayerController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+	GetOrCreateHUDViewModel()->SetCharacter(Cast<APlayerCharacter>(InPawn));
+}
+
+void AActionPlayerController::OnUnPossess()
+{
+	Super::OnUnPossess();
+
+	if (HUDViewModel != nullptr)
+	{
+		HUDViewModel->SetCharacter(nullptr);
 	}
 }
 
+UPlayerHUDViewModel* AActionPlayerController::GetOrCreateHUDViewModel()
+{
+	if (HUDViewModel == nullptr)
+	{
+		AP_LLM_SCOPE(HUD);
+		HUDViewModel = NewObject<UPlayerHUDViewModel>(this);
+	}
 
+	return HUDViewModel;
+}
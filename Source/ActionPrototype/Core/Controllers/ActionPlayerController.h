@@ -7,6 +7,7 @@
 #include "ActionPlayerController.generated.h"
 
 class UUserWidget;
+class UPlayerHUDViewModel;
 
 /**
  * 
@@ -17,13 +18,24 @@ class ACTIONPROTOTYPE_API AActionPlayerController : public APlayerController
 	GENERATED_BODY()
 
 public:
+	/** If it's derived from UActionHUDWidget, values are pushed to it by the HUD view model. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="User Interface")
 	TSubclassOf<UUserWidget> PlayerHUDClass{nullptr};
 
 	UPROPERTY(BlueprintReadOnly, Category="User Interface")
 	UUserWidget* PlayerHUD{nullptr};
 
+	UFUNCTION(BlueprintPure, Category="User Interface")
+	FORCEINLINE UPlayerHUDViewModel* GetHUDViewModel() const { return HUDViewModel; }
+
 protected:
 	virtual void BeginPlay() override;
-	
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	UPROPERTY()
+	UPlayerHUDViewModel* HUDViewModel{nullptr};
+
+	UPlayerHUDViewModel* GetOrCreateHUDViewModel();
 };
@@ -0,0 +1,9 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelAssetBundle.h"
+
+FPrimaryAssetId ULevelAssetBundle::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId{TEXT("LevelAssetBundle"), GetFName()};
+}
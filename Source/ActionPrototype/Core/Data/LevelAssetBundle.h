@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "LevelAssetBundle.generated.h"
+
+/**
+ * Weapons, montages and effects streamed in while a level is loading, so actors of the level find them resident.
+ */
+UCLASS(BlueprintType)
+class ACTIONPROTOTYPE_API ULevelAssetBundle : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Level Asset Bundle")
+	TArray<TSoftObjectPtr<UObject>> Assets{};
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Level Asset Bundle")
+	TArray<TSoftClassPtr<UObject>> Classes{};
+};
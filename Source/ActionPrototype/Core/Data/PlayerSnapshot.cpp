@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlayerSnapshot.h"
+
+#include "ActionPrototype/Actors/Weapon.h"
+
+bool FPlayerSnapshot::Serialize(FArchive& Archive)
+{
+	uint8 SnapshotVersion = Version;
+	Archive << SnapshotVersion;
+
+	if (Archive.IsLoading() && SnapshotVersion != Version)
+	{
+		return false;
+	}
+
+	Archive << Health;
+	Archive << MaxHealth;
+	Archive << Stamina;
+	Archive << MaxStamina;
+	Archive << Coins;
+	Archive << MagnetRadius;
+
+	// Classes are stored as paths, so the snapshot doesn't keep them loaded through the transition
+	FString LeftWeaponPath = LeftWeaponClass.ToString();
+	FString RightWeaponPath = RightWeaponClass.ToString();
+	Archive << LeftWeaponPath;
+	Archive << RightWeaponPath;
+
+	if (Archive.IsLoading())
+	{
+		LeftWeaponClass = TSoftClassPtr<AWeapon>{FSoftObjectPath{LeftWeaponPath}};
+		RightWeaponClass = TSoftClassPtr<AWeapon>{FSoftObjectPath{RightWeaponPath}};
+	}
+
+	return !Archive.IsError();
+}
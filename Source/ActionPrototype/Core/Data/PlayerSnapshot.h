@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AWeapon;
+
+/**
+ * Player state carried over level transitions. Serialized into a versioned binary blob,
+ * blobs of other versions are discarded rather than migrated.
+ */
+struct ACTIONPROTOTYPE_API FPlayerSnapshot
+{
+	/** Must be increased whenever the serialized layout changes. */
+	static constexpr uint8 Version{1};
+
+	float Health{0.f};
+	float MaxHealth{0.f};
+	float Stamina{0.f};
+	float MaxStamina{0.f};
+	int32 Coins{0};
+	float MagnetRadius{0.f};
+	TSoftClassPtr<AWeapon> LeftWeaponClass{};
+	TSoftClassPtr<AWeapon> RightWeaponClass{};
+
+	/** Writes the snapshot or reads it depending on Archive.IsLoading().
+	 * Returns false if the read data has another version or is corrupted.
+	 */
+	bool Serialize(FArchive& Archive);
+};
@@ -0,0 +1,261 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetStreamingSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Core/Data/LevelAssetBundle.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Streamed Assets"), STAT_StreamedAssets, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Asset Stream Requests"), STAT_AssetStreamRequests, STATGROUP_ActionPrototype);
+
+void UAssetStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UAssetStreamingSubsystem::HandlePreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(
+																				this,
+																				&UAssetStreamingSubsystem::HandlePostLoadMap
+																			   );
+}
+
+void UAssetStreamingSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	for (TPair<FSoftObjectPath, FStreamedAsset>& StreamedAsset : StreamedAssets)
+	{
+		if (StreamedAsset.Value.Handle.IsValid())
+		{
+			StreamedAsset.Value.Handle->ReleaseHandle();
+		}
+	}
+
+	StreamedAssets.Empty();
+	CurrentBundleAssets.Empty();
+	PreviousBundleAssets.Empty();
+	SET_DWORD_STAT(STAT_StreamedAssets, 0);
+	Super::Deinitialize();
+}
+
+UAssetStreamingSubsystem* UAssetStreamingSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine != nullptr
+		                      ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		                      : nullptr;
+	const UGameInstance* GameInstance = World != nullptr ? World->GetGameInstance() : nullptr;
+	return GameInstance != nullptr ? GameInstance->GetSubsystem<UAssetStreamingSubsystem>() : nullptr;
+}
+
+void UAssetStreamingSubsystem::RequestAsset(const FSoftObjectPath& AssetPath, FOnAssetStreamed OnStreamed)
+{
+	if (AssetPath.IsNull())
+	{
+		OnStreamed.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	FStreamedAsset& StreamedAsset = StreamedAssets.FindOrAdd(AssetPath);
+	++StreamedAsset.UsersNumber;
+
+	if (StreamedAsset.Handle.IsValid() && StreamedAsset.Handle->HasLoadCompleted())
+	{
+		OnStreamed.ExecuteIfBound(AssetPath.ResolveObject());
+		return;
+	}
+
+	if (OnStreamed.IsBound())
+	{
+		StreamedAsset.PendingCallbacks.Add(MoveTemp(OnStreamed));
+	}
+
+	if (!StreamedAsset.Handle.IsValid())
+	{
+		INC_DWORD_STAT(STAT_AssetStreamRequests);
+		SET_DWORD_STAT(STAT_StreamedAssets, StreamedAssets.Num());
+		// The handle may complete immediately for resident assets, so it's assigned through the map again
+		TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+																				   AssetPath,
+																				   FStreamableDelegate::CreateUObject(
+																					   this,
+																					   &UAssetStreamingSubsystem::HandleAssetStreamed,
+																					   AssetPath
+																					  )
+																				  );
+		FStreamedAsset* RequestedAsset = StreamedAssets.Find(AssetPath);
+
+		if (RequestedAsset != nullptr)
+		{
+			RequestedAsset->Handle = Handle;
+		}
+	}
+}
+
+void UAssetStreamingSubsystem::ReleaseAsset(const FSoftObjectPath& AssetPath)
+{
+	FStreamedAsset* StreamedAsset = StreamedAssets.Find(AssetPath);
+
+	if (StreamedAsset == nullptr || --StreamedAsset->UsersNumber > 0)
+	{
+		return;
+	}
+
+	if (StreamedAsset->Handle.IsValid())
+	{
+		StreamedAsset->Handle->ReleaseHandle();
+	}
+
+	StreamedAssets.Remove(AssetPath);
+	SET_DWORD_STAT(STAT_StreamedAssets, StreamedAssets.Num());
+}
+
+void UAssetStreamingSubsystem::HandleAssetStreamed(const FSoftObjectPath AssetPath)
+{
+	FStreamedAsset* StreamedAsset = StreamedAssets.Find(AssetPath);
+
+	if (StreamedAsset == nullptr)
+	{
+		return;
+	}
+
+	TArray<FOnAssetStreamed> Callbacks = MoveTemp(StreamedAsset->PendingCallbacks);
+	UObject* Asset = AssetPath.ResolveObject();
+
+	if (Asset == nullptr)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Failed to stream asset %s."), *AssetPath.ToString());
+	}
+
+	for (FOnAssetStreamed& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(Asset);
+	}
+}
+
+void UAssetStreamingSubsystem::HandlePreLoadMap(const FString& MapName)
+{
+	MapLoadStartTime = FPlatformTime::Seconds();
+	MapLoadStartMemory = FPlatformMemory::GetStats().UsedPhysical;
+	PreloadLevelBundle(MapName);
+}
+
+void UAssetStreamingSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (LoadedWorld == nullptr)
+	{
+		return;
+	}
+
+	const FString MapName = UWorld::RemovePIEPrefix(LoadedWorld->GetMapName());
+	const uint64 UsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+
+	if (MapLoadStartTime > 0.0)
+	{
+		UE_LOG(
+			   LogActionPrototype,
+			   Log,
+			   TEXT("Map %s loaded in %.3f s, resident memory %.1f MB (%+.1f MB), %d streamed assets."),
+			   *MapName,
+			   FPlatformTime::Seconds() - MapLoadStartTime,
+			   UsedMemory / (1024.0 * 1024.0),
+			   (static_cast<double>(UsedMemory) - static_cast<double>(MapLoadStartMemory)) / (1024.0 * 1024.0),
+			   StreamedAssets.Num()
+			  );
+	}
+	else
+	{
+		// Maps opened in PIE don't go through PreLoadMap
+		PreloadLevelBundle(MapName);
+		UE_LOG(
+			   LogActionPrototype,
+			   Log,
+			   TEXT("Map %s loaded, resident memory %.1f MB."),
+			   *MapName,
+			   UsedMemory / (1024.0 * 1024.0)
+			  );
+	}
+
+	MapLoadStartTime = 0.0;
+}
+
+void UAssetStreamingSubsystem::PreloadLevelBundle(const FString& MapName)
+{
+	const FName ShortMapName{*FPackageName::GetShortName(MapName)};
+	const FLevelAssetBundleEntry* BundleEntry = LevelAssetBundles.FindByPredicate(
+																				  [&ShortMapName](const FLevelAssetBundleEntry& Entry)
+																				  {
+																					  return Entry.MapName == ShortMapName;
+																				  }
+																				 );
+	const FSoftObjectPath BundlePath = BundleEntry != nullptr ? BundleEntry->Bundle.ToSoftObjectPath() : FSoftObjectPath{};
+
+	if (BundlePath == CurrentBundlePath)
+	{
+		return;
+	}
+
+	ReleasePreviousLevelBundle();
+	PreviousBundlePath = CurrentBundlePath;
+	PreviousBundleAssets = MoveTemp(CurrentBundleAssets);
+	CurrentBundlePath = BundlePath;
+	CurrentBundleAssets.Reset();
+
+	if (BundlePath.IsNull())
+	{
+		ReleasePreviousLevelBundle();
+		return;
+	}
+
+	RequestAsset(
+				 BundlePath,
+				 FOnAssetStreamed::CreateUObject(this, &UAssetStreamingSubsystem::HandleLevelBundleStreamed, BundlePath)
+				);
+}
+
+void UAssetStreamingSubsystem::HandleLevelBundleStreamed(UObject* BundleObject, const FSoftObjectPath BundlePath)
+{
+	const ULevelAssetBundle* Bundle = Cast<ULevelAssetBundle>(BundleObject);
+
+	if (Bundle != nullptr && BundlePath == CurrentBundlePath && CurrentBundleAssets.Num() == 0)
+	{
+		for (const TSoftObjectPtr<UObject>& Asset : Bundle->Assets)
+		{
+			CurrentBundleAssets.Add(Asset.ToSoftObjectPath());
+		}
+
+		for (const TSoftClassPtr<UObject>& Class : Bundle->Classes)
+		{
+			CurrentBundleAssets.Add(Class.ToSoftObjectPath());
+		}
+
+		for (const FSoftObjectPath& AssetPath : CurrentBundleAssets)
+		{
+			RequestAsset(AssetPath);
+		}
+	}
+
+	ReleasePreviousLevelBundle();
+}
+
+void UAssetStreamingSubsystem::ReleasePreviousLevelBundle()
+{
+	for (const FSoftObjectPath& AssetPath : PreviousBundleAssets)
+	{
+		ReleaseAsset(AssetPath);
+	}
+
+	if (!PreviousBundlePath.IsNull())
+	{
+		ReleaseAsset(PreviousBundlePath);
+	}
+
+	PreviousBundleAssets.Reset();
+	PreviousBundlePath.Reset();
+}
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "AssetStreamingSubsystem.generated.h"
+
+class ULevelAssetBundle;
+
+DECLARE_DELEGATE_OneParam(FOnAssetStreamed, UObject*);
+
+/** Bundle pre-loaded while the map with the given name is loading. */
+USTRUCT()
+struct FLevelAssetBundleEntry
+{
+	GENERATED_BODY()
+
+	/** Short name of the map package. */
+	UPROPERTY(EditAnywhere, Category="Level Asset Bundle")
+	FName MapName{NAME_None};
+	UPROPERTY(EditAnywhere, Category="Level Asset Bundle")
+	TSoftObjectPtr<ULevelAssetBundle> Bundle{};
+};
+
+/**
+ * Streams soft referenced assets asynchronously and keeps them resident while they have users.
+ * Also pre-loads per-level bundles set up in the config and logs map load times and resident memory.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UAssetStreamingSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UAssetStreamingSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Adds a user to the given asset and streams it if needed.
+	 * @param OnStreamed - called with the loaded asset, immediately if it's already resident;
+	 */
+	void RequestAsset(const FSoftObjectPath& AssetPath, FOnAssetStreamed OnStreamed = FOnAssetStreamed{});
+	/** Removes a user from the given asset, the asset can be garbage collected once it has no users. */
+	void ReleaseAsset(const FSoftObjectPath& AssetPath);
+
+	UFUNCTION(BlueprintPure, Category="Asset Streaming")
+	FORCEINLINE int32 GetCachedAssetsNumber() const { return StreamedAssets.Num(); }
+
+private:
+	struct FStreamedAsset
+	{
+		TSharedPtr<FStreamableHandle> Handle{};
+		int32 UsersNumber{0};
+		TArray<FOnAssetStreamed> PendingCallbacks{};
+	};
+
+	UPROPERTY(Config)
+	TArray<FLevelAssetBundleEntry> LevelAssetBundles{};
+
+	FStreamableManager StreamableManager{};
+	TMap<FSoftObjectPath, FStreamedAsset> StreamedAssets{};
+
+	FSoftObjectPath CurrentBundlePath{};
+	TArray<FSoftObjectPath> CurrentBundleAssets{};
+	/** Kept until the contents of the current bundle are requested, so shared assets aren't unloaded in between. */
+	FSoftObjectPath PreviousBundlePath{};
+	TArray<FSoftObjectPath> PreviousBundleAssets{};
+
+	double MapLoadStartTime{0.0};
+	uint64 MapLoadStartMemory{0};
+	FDelegateHandle PreLoadMapHandle{};
+	FDelegateHandle PostLoadMapHandle{};
+
+	void HandleAssetStreamed(const FSoftObjectPath AssetPath);
+	void HandlePreLoadMap(const FString& MapName);
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+	void PreloadLevelBundle(const FString& MapName);
+	void HandleLevelBundleStreamed(UObject* BundleObject, const FSoftObjectPath BundlePath);
+	void ReleasePreviousLevelBundle();
+};
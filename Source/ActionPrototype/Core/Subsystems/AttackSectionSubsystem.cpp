@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AttackSectionSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "Algo/BinarySearch.h"
+#include "Animation/AnimMontage.h"
+
+int32 FAttackSectionTable::SelectSection(const FRandomStream& RandomStream, const int32 PreviousIndex) const
+{
+	if (Sections.IsValidIndex(PreviousIndex) && Sections[PreviousIndex].ComboIndex != INDEX_NONE)
+	{
+		return Sections[PreviousIndex].ComboIndex;
+	}
+
+	if (TotalWeight <= 0.f)
+	{
+		return INDEX_NONE;
+	}
+
+	const float Roll = RandomStream.FRandRange(0.f, TotalWeight);
+	const int32 Index = Algo::UpperBoundBy(Sections, Roll, &FEntry::CumulativeWeight);
+	return FMath::Min(Index, Sections.Num() - 1);
+}
+
+void UAttackSectionSubsystem::Deinitialize()
+{
+	SectionTables.Empty();
+	Super::Deinitialize();
+}
+
+TSharedPtr<const FAttackSectionTable> UAttackSectionSubsystem::GetSectionTable(
+	const UClass* CharacterClass,
+	const UAnimMontage* Montage,
+	const TArray<FAttackSection>& Sections,
+	const TArray<FName>& DefaultSectionsNames)
+{
+	const FObjectKey ClassKey{CharacterClass};
+	const TSharedPtr<const FAttackSectionTable>* CachedTable = SectionTables.Find(ClassKey);
+
+	if (CachedTable != nullptr)
+	{
+		return *CachedTable;
+	}
+
+	TSharedPtr<const FAttackSectionTable> Table = BuildSectionTable(Montage, Sections, DefaultSectionsNames);
+
+	if (Montage != nullptr)
+	{
+		SectionTables.Add(ClassKey, Table);
+	}
+
+	return Table;
+}
+
+TSharedPtr<const FAttackSectionTable> UAttackSectionSubsystem::BuildSectionTable(
+	const UAnimMontage* Montage,
+	const TArray<FAttackSection>& Sections,
+	const TArray<FName>& DefaultSectionsNames)
+{
+	TSharedPtr<FAttackSectionTable> Table = MakeShared<FAttackSectionTable>();
+	TArray<FAttackSection> ResolvedSections{Sections};
+
+	if (ResolvedSections.Num() == 0)
+	{
+		for (const FName& SectionName : DefaultSectionsNames)
+		{
+			FAttackSection& Section = ResolvedSections.AddDefaulted_GetRef();
+			Section.SectionName = SectionName;
+		}
+	}
+
+	Table->Sections.Reserve(ResolvedSections.Num());
+
+	for (const FAttackSection& Section : ResolvedSections)
+	{
+		const int32 MontageSectionIndex = Montage != nullptr ? Montage->GetSectionIndex(Section.SectionName) : INDEX_NONE;
+
+		if (Montage != nullptr && MontageSectionIndex == INDEX_NONE)
+		{
+			UE_LOG(
+				   LogActionPrototype,
+				   Warning,
+				   TEXT("Attack section %s isn't found in montage %s."),
+				   *Section.SectionName.ToString(),
+				   *Montage->GetName()
+				  );
+			continue;
+		}
+
+		FAttackSectionTable::FEntry& Entry = Table->Sections.AddDefaulted_GetRef();
+		Entry.SectionName = Section.SectionName;
+		Table->TotalWeight += FMath::Max(Section.Weight, 0.f);
+		Entry.CumulativeWeight = Table->TotalWeight;
+	}
+
+	for (const FAttackSection& Section : ResolvedSections)
+	{
+		if (Section.ComboSection.IsNone())
+		{
+			continue;
+		}
+
+		const int32 Index = Table->Sections.IndexOfByPredicate(
+															   [&Section](const FAttackSectionTable::FEntry& Entry)
+															   {
+																   return Entry.SectionName == Section.SectionName;
+															   }
+															  );
+		const int32 ComboIndex = Table->Sections.IndexOfByPredicate(
+																	[&Section](const FAttackSectionTable::FEntry& Entry)
+																	{
+																		return Entry.SectionName == Section.ComboSection;
+																	}
+																   );
+
+		if (Index != INDEX_NONE)
+		{
+			Table->Sections[Index].ComboIndex = ComboIndex;
+		}
+	}
+
+	return Table;
+}
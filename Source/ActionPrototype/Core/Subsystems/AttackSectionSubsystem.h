@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "AttackSectionSubsystem.generated.h"
+
+class UAnimMontage;
+
+/** Attack montage section as it is set up in the editor. */
+USTRUCT(BlueprintType)
+struct FAttackSection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attack Section")
+	FName SectionName{NAME_None};
+	/** Relative chance of picking this section, sections with zero weight are played only as combo links. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attack Section", meta=(ClampMin="0.0"))
+	float Weight{1.f};
+	/** Section played next if the attack continues, none ends the combo. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attack Section")
+	FName ComboSection{NAME_None};
+};
+
+/** Attack sections of a character class resolved against its montage. */
+struct FAttackSectionTable
+{
+	struct FEntry
+	{
+		FName SectionName{NAME_None};
+		/** Sum of weights of this and all previous sections. */
+		float CumulativeWeight{0.f};
+		int32 ComboIndex{INDEX_NONE};
+	};
+
+	TArray<FEntry> Sections{};
+	float TotalWeight{0.f};
+
+	/** Returns the combo link of the previous section if there is one, otherwise picks a weighted random section.
+	 * Returns INDEX_NONE if the table is empty.
+	 */
+	int32 SelectSection(const FRandomStream& RandomStream, const int32 PreviousIndex = INDEX_NONE) const;
+};
+
+/**
+ * Builds attack section tables once per character class and shares them between all instances.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API UAttackSectionSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Returns the cached table of the given class, building it from the given sections on the first request.
+	 * A table built without a montage isn't cached, so it's resolved again once the montage is loaded.
+	 * @param DefaultSectionsNames - sections with equal weights used if Sections is empty;
+	 */
+	TSharedPtr<const FAttackSectionTable> GetSectionTable(
+		const UClass* CharacterClass,
+		const UAnimMontage* Montage,
+		const TArray<FAttackSection>& Sections,
+		const TArray<FName>& DefaultSectionsNames);
+
+	static TSharedPtr<const FAttackSectionTable> BuildSectionTable(
+		const UAnimMontage* Montage,
+		const TArray<FAttackSection>& Sections,
+		const TArray<FName>& DefaultSectionsNames);
+
+private:
+	TMap<FObjectKey, TSharedPtr<const FAttackSectionTable>> SectionTables{};
+};
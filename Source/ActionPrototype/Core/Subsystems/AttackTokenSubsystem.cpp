@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AttackTokenSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Token Holders"), STAT_AttackTokenHolders, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Tokens Denied"), STAT_AttackTokensDenied, STATGROUP_ActionPrototype);
+
+void UAttackTokenSubsystem::Deinitialize()
+{
+	TokenHolders.Empty();
+	SET_DWORD_STAT(STAT_AttackTokenHolders, 0);
+	Super::Deinitialize();
+}
+
+bool UAttackTokenSubsystem::RequestToken(AEnemyCharacter* Enemy)
+{
+	if (Enemy == nullptr)
+	{
+		return false;
+	}
+
+	if (TokenHolders.Contains(Enemy))
+	{
+		return true;
+	}
+
+	if (TokenHolders.Num() >= MaxAttackers)
+	{
+		INC_DWORD_STAT(STAT_AttackTokensDenied);
+		return false;
+	}
+
+	TokenHolders.Add(Enemy);
+	SET_DWORD_STAT(STAT_AttackTokenHolders, TokenHolders.Num());
+	return true;
+}
+
+void UAttackTokenSubsystem::ReleaseToken(AEnemyCharacter* Enemy)
+{
+	if (TokenHolders.RemoveSingleSwap(Enemy, false) > 0)
+	{
+		SET_DWORD_STAT(STAT_AttackTokenHolders, TokenHolders.Num());
+	}
+}
+
+bool UAttackTokenSubsystem::HasToken(const AEnemyCharacter* Enemy) const
+{
+	return TokenHolders.Contains(Enemy);
+}
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AttackTokenSubsystem.generated.h"
+
+class AEnemyCharacter;
+
+/**
+ * Grants a limited number of attack tokens to enemies around the player.
+ * Only token holders play attack montages, the rest hold position until a token is released.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UAttackTokenSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Returns true if the enemy already holds a token or a free one was granted to it. */
+	bool RequestToken(AEnemyCharacter* Enemy);
+	void ReleaseToken(AEnemyCharacter* Enemy);
+	bool HasToken(const AEnemyCharacter* Enemy) const;
+
+	UFUNCTION(BlueprintPure, Category="Attack Tokens")
+	FORCEINLINE int32 GetTokenHoldersNumber() const { return TokenHolders.Num(); }
+
+	/** Maximum number of enemies attacking the player simultaneously. */
+	UPROPERTY(Config)
+	int32 MaxAttackers{3};
+
+private:
+	UPROPERTY()
+	TArray<AEnemyCharacter*> TokenHolders{};
+};
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CombatTextSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/BaseCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Texts Merged"), STAT_CombatTextsMerged, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Texts Recycled"), STAT_CombatTextsRecycled, STATGROUP_ActionPrototype);
+
+void UCombatTextSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	AP_LLM_SCOPE(HUD);
+	CombatTexts.SetNum(FMath::Max(MaxCombatTexts, 1));
+	HealthBars.SetNum(FMath::Max(MaxHealthBars, 0));
+}
+
+void UCombatTextSubsystem::Deinitialize()
+{
+	CombatTexts.Empty();
+	HealthBars.Empty();
+	Super::Deinitialize();
+}
+
+void UCombatTextSubsystem::AddDamage(const ABaseCharacter* Character, const float Amount)
+{
+	if (Character == nullptr || Amount <= 0.f)
+	{
+		return;
+	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	AddCombatText(Character, Amount, CurrentTime);
+	AddHealthBar(Character, CurrentTime);
+}
+
+bool UCombatTextSubsystem::IsActive(const FCombatTextEntry& Entry, const float CurrentTime) const
+{
+	return Entry.StartTime >= 0.f && CurrentTime - Entry.StartTime < CombatTextDuration;
+}
+
+bool UCombatTextSubsystem::IsActive(const FHealthBarEntry& Entry, const float CurrentTime) const
+{
+	return Entry.StartTime >= 0.f && Entry.Character.IsValid() && CurrentTime - Entry.StartTime < HealthBarDuration;
+}
+
+void UCombatTextSubsystem::AddCombatText(const ABaseCharacter* Character, const float Amount, const float CurrentTime)
+{
+	FCombatTextEntry* LatestEntry{nullptr};
+	FCombatTextEntry* FreeEntry{nullptr};
+	FCombatTextEntry* OldestEntry{nullptr};
+
+	for (FCombatTextEntry& Entry : CombatTexts)
+	{
+		if (!IsActive(Entry, CurrentTime))
+		{
+			FreeEntry = FreeEntry != nullptr ? FreeEntry : &Entry;
+			continue;
+		}
+
+		if (Entry.Character == Character && (LatestEntry == nullptr || Entry.StartTime > LatestEntry->StartTime))
+		{
+			LatestEntry = &Entry;
+		}
+
+		if (OldestEntry == nullptr || Entry.StartTime < OldestEntry->StartTime)
+		{
+			OldestEntry = &Entry;
+		}
+	}
+
+	// Out of entries, the number already shown above the character absorbs the damage regardless of its age
+	if (LatestEntry != nullptr && (CurrentTime - LatestEntry->StartTime <= MergeWindow || FreeEntry == nullptr))
+	{
+		LatestEntry->Amount += Amount;
+		LatestEntry->StartTime = CurrentTime;
+		INC_DWORD_STAT(STAT_CombatTextsMerged);
+		return;
+	}
+
+	FCombatTextEntry* Entry = FreeEntry != nullptr ? FreeEntry : OldestEntry;
+
+	if (Entry == nullptr)
+	{
+		return;
+	}
+
+	if (FreeEntry == nullptr)
+	{
+		INC_DWORD_STAT(STAT_CombatTextsRecycled);
+	}
+
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+	Entry->Character = Character;
+	Entry->Location = Character->GetActorLocation() + FVector{
+		0.f,
+		0.f,
+		Capsule != nullptr ? Capsule->GetScaledCapsuleHalfHeight() : 0.f
+	};
+	Entry->Amount = Amount;
+	Entry->StartTime = CurrentTime;
+}
+
+void UCombatTextSubsystem::AddHealthBar(const ABaseCharacter* Character, const float CurrentTime)
+{
+	FHealthBarEntry* FreeEntry{nullptr};
+	FHealthBarEntry* OldestEntry{nullptr};
+
+	for (FHealthBarEntry& Entry : HealthBars)
+	{
+		if (Entry.Character == Character)
+		{
+			Entry.StartTime = CurrentTime;
+			return;
+		}
+
+		if (!IsActive(Entry, CurrentTime))
+		{
+			FreeEntry = FreeEntry != nullptr ? FreeEntry : &Entry;
+		}
+		else if (OldestEntry == nullptr || Entry.StartTime < OldestEntry->StartTime)
+		{
+			OldestEntry = &Entry;
+		}
+	}
+
+	FHealthBarEntry* Entry = FreeEntry != nullptr ? FreeEntry : OldestEntry;
+
+	if (Entry != nullptr)
+	{
+		Entry->Character = Character;
+		Entry->StartTime = CurrentTime;
+	}
+}
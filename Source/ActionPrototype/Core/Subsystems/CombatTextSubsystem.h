@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTextSubsystem.generated.h"
+
+class ABaseCharacter;
+
+/** Damage number shown above a damaged character. */
+struct FCombatTextEntry
+{
+	TWeakObjectPtr<const ABaseCharacter> Character{nullptr};
+	/** World location of the hit, the text rises from it. */
+	FVector Location{FVector::ZeroVector};
+	float Amount{0.f};
+	/** World time of the last added damage, < 0 if the entry is free. */
+	float StartTime{-1.f};
+};
+
+/** Health bar shown above a recently damaged character. */
+struct FHealthBarEntry
+{
+	TWeakObjectPtr<const ABaseCharacter> Character{nullptr};
+	float StartTime{-1.f};
+};
+
+/**
+ * Keeps fixed pools of damage numbers and health bars of damaged characters, drawn by AActionHUD in one canvas pass.
+ * When the pools are exhausted new damage is merged into the numbers already shown, the oldest entries are reused last.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UCombatTextSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Shows the damage number and the health bar of the given character. */
+	void AddDamage(const ABaseCharacter* Character, const float Amount);
+
+	FORCEINLINE const TArray<FCombatTextEntry>& GetCombatTexts() const { return CombatTexts; }
+	FORCEINLINE const TArray<FHealthBarEntry>& GetHealthBars() const { return HealthBars; }
+	bool IsActive(const FCombatTextEntry& Entry, const float CurrentTime) const;
+	bool IsActive(const FHealthBarEntry& Entry, const float CurrentTime) const;
+
+	/** Size of the damage numbers pool, applied on world initialization. */
+	UPROPERTY(Config)
+	int32 MaxCombatTexts{48};
+	/** Size of the health bars pool, applied on world initialization. */
+	UPROPERTY(Config)
+	int32 MaxHealthBars{16};
+	/** Seconds the damage numbers and the health bars are shown. */
+	UPROPERTY(Config)
+	float CombatTextDuration{1.f};
+	UPROPERTY(Config)
+	float HealthBarDuration{3.f};
+	/** Damage to the same character within this time is added to the shown number. */
+	UPROPERTY(Config)
+	float MergeWindow{0.15f};
+
+private:
+	TArray<FCombatTextEntry> CombatTexts{};
+	TArray<FHealthBarEntry> HealthBars{};
+
+	void AddCombatText(const ABaseCharacter* Character, const float Amount, const float CurrentTime);
+	void AddHealthBar(const ABaseCharacter* Character, const float CurrentTime);
+};
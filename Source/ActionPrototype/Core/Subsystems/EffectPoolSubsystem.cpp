@@ -0,0 +1,352 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EffectPoolSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "Components/AudioComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Sound/SoundBase.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Components Active"), STAT_EffectComponentsActive, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Components Free"), STAT_EffectComponentsFree, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Allocations Saved"), STAT_EffectAllocationsSaved, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effects Culled"), STAT_EffectsCulled, STATGROUP_ActionPrototype);
+
+void UEffectPoolSubsystem::Deinitialize()
+{
+	for (TPair<UParticleSystem*, FParticleComponentPool>& Pool : ParticlePools)
+	{
+		for (UParticleSystemComponent* Component : Pool.Value.FreeComponents)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+			}
+		}
+
+		for (UParticleSystemComponent* Component : Pool.Value.ActiveComponents)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+			}
+		}
+	}
+
+	for (TPair<USoundBase*, FAudioComponentPool>& Pool : AudioPools)
+	{
+		for (UAudioComponent* Component : Pool.Value.FreeComponents)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+			}
+		}
+
+		for (UAudioComponent* Component : Pool.Value.ActiveComponents)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+			}
+		}
+	}
+
+	ParticlePools.Empty();
+	AudioPools.Empty();
+	UpdateStats();
+	Super::Deinitialize();
+}
+
+bool UEffectPoolSubsystem::PlayEmitterAtLocation(
+	UParticleSystem* Template,
+	const FVector& Location,
+	const FRotator& Rotation)
+{
+	if (Template == nullptr)
+	{
+		return false;
+	}
+
+	if (IsCulled(Location))
+	{
+		INC_DWORD_STAT(STAT_EffectsCulled);
+		return false;
+	}
+
+	FParticleComponentPool& Pool = ParticlePools.FindOrAdd(Template);
+	PruneActiveComponents(Pool);
+	UParticleSystemComponent* Component{nullptr};
+
+	if (Pool.ActiveComponents.Num() >= FMath::Max(MaxConcurrentPerEffect, 1))
+	{
+		// The oldest instance is restarted, so a new effect is never dropped
+		Component = Pool.ActiveComponents[0];
+		Pool.ActiveComponents.RemoveAt(0, 1, false);
+	}
+
+	while (Pool.FreeComponents.Num() > 0 && Component == nullptr)
+	{
+		Component = Pool.FreeComponents.Pop(false);
+
+		if (!IsValid(Component))
+		{
+			Component = nullptr;
+		}
+	}
+
+	if (Component != nullptr)
+	{
+		++SavedAllocationsNumber;
+	}
+	else
+	{
+		Component = CreateParticleComponent(Template);
+
+		if (Component == nullptr)
+		{
+			return false;
+		}
+	}
+
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->ActivateSystem(true);
+	Pool.ActiveComponents.Add(Component);
+	UpdateStats();
+	return true;
+}
+
+bool UEffectPoolSubsystem::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location)
+{
+	if (Sound == nullptr)
+	{
+		return false;
+	}
+
+	if (IsCulled(Location))
+	{
+		INC_DWORD_STAT(STAT_EffectsCulled);
+		return false;
+	}
+
+	FAudioComponentPool& Pool = AudioPools.FindOrAdd(Sound);
+	PruneActiveComponents(Pool);
+	UAudioComponent* Component{nullptr};
+
+	if (Pool.ActiveComponents.Num() >= FMath::Max(MaxConcurrentPerEffect, 1))
+	{
+		Component = Pool.ActiveComponents[0];
+		Pool.ActiveComponents.RemoveAt(0, 1, false);
+		// Stopping calls the finished callback, which ignores components that aren't active
+		Component->Stop();
+	}
+
+	while (Pool.FreeComponents.Num() > 0 && Component == nullptr)
+	{
+		Component = Pool.FreeComponents.Pop(false);
+
+		if (!IsValid(Component))
+		{
+			Component = nullptr;
+		}
+	}
+
+	if (Component != nullptr)
+	{
+		++SavedAllocationsNumber;
+	}
+	else
+	{
+		Component = CreateAudioComponent(Sound);
+
+		if (Component == nullptr)
+		{
+			return false;
+		}
+	}
+
+	Component->SetWorldLocation(Location);
+	Component->Play();
+	Pool.ActiveComponents.Add(Component);
+	UpdateStats();
+	return true;
+}
+
+void UEffectPoolSubsystem::PlayEffectsAtLocation(UParticleSystem* Template, USoundBase* Sound, const FVector& Location)
+{
+	PlayEmitterAtLocation(Template, Location, FRotator::ZeroRotator);
+	PlaySoundAtLocation(Sound, Location);
+}
+
+int32 UEffectPoolSubsystem::GetActiveComponentsNumber() const
+{
+	int32 ComponentsNumber = 0;
+
+	for (const TPair<UParticleSystem*, FParticleComponentPool>& Pool : ParticlePools)
+	{
+		ComponentsNumber += Pool.Value.ActiveComponents.Num();
+	}
+
+	for (const TPair<USoundBase*, FAudioComponentPool>& Pool : AudioPools)
+	{
+		ComponentsNumber += Pool.Value.ActiveComponents.Num();
+	}
+
+	return ComponentsNumber;
+}
+
+int32 UEffectPoolSubsystem::GetFreeComponentsNumber() const
+{
+	int32 ComponentsNumber = 0;
+
+	for (const TPair<UParticleSystem*, FParticleComponentPool>& Pool : ParticlePools)
+	{
+		ComponentsNumber += Pool.Value.FreeComponents.Num();
+	}
+
+	for (const TPair<USoundBase*, FAudioComponentPool>& Pool : AudioPools)
+	{
+		ComponentsNumber += Pool.Value.FreeComponents.Num();
+	}
+
+	return ComponentsNumber;
+}
+
+bool UEffectPoolSubsystem::IsCulled(const FVector& Location) const
+{
+	if (CullDistance <= 0.f)
+	{
+		return false;
+	}
+
+	const UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World != nullptr ? World->GetFirstPlayerController() : nullptr;
+
+	if (PlayerController == nullptr)
+	{
+		return false;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	return FVector::DistSquared(ViewLocation, Location) > FMath::Square(CullDistance);
+}
+
+UParticleSystemComponent* UEffectPoolSubsystem::CreateParticleComponent(UParticleSystem* Template)
+{
+	UWorld* World = GetWorld();
+
+	if (World == nullptr || World->GetWorldSettings() == nullptr)
+	{
+		return {nullptr};
+	}
+
+	UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(World->GetWorldSettings());
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->SetUsingAbsoluteLocation(true);
+	Component->SetUsingAbsoluteRotation(true);
+	Component->SetTemplate(Template);
+	Component->OnSystemFinished.AddDynamic(this, &UEffectPoolSubsystem::ReleaseParticleComponent);
+	Component->RegisterComponentWithWorld(World);
+	return Component;
+}
+
+UAudioComponent* UEffectPoolSubsystem::CreateAudioComponent(USoundBase* Sound)
+{
+	UWorld* World = GetWorld();
+
+	if (World == nullptr || World->GetWorldSettings() == nullptr)
+	{
+		return {nullptr};
+	}
+
+	UAudioComponent* Component = NewObject<UAudioComponent>(World->GetWorldSettings());
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->bAllowSpatialization = true;
+	Component->SetUsingAbsoluteLocation(true);
+	Component->SetSound(Sound);
+	Component->OnAudioFinishedNative.AddUObject(this, &UEffectPoolSubsystem::ReleaseAudioComponent);
+	Component->RegisterComponentWithWorld(World);
+	return Component;
+}
+
+void UEffectPoolSubsystem::ReleaseParticleComponent(UParticleSystemComponent* Component)
+{
+	FParticleComponentPool* Pool = ParticlePools.Find(Component->Template);
+
+	if (Pool == nullptr || Pool->ActiveComponents.RemoveSingle(Component) == 0)
+	{
+		return;
+	}
+
+	Pool->FreeComponents.Add(Component);
+	UpdateStats();
+}
+
+void UEffectPoolSubsystem::ReleaseAudioComponent(UAudioComponent* Component)
+{
+	FAudioComponentPool* Pool = AudioPools.Find(Component->Sound);
+
+	if (Pool == nullptr || Pool->ActiveComponents.RemoveSingle(Component) == 0)
+	{
+		return;
+	}
+
+	Pool->FreeComponents.Add(Component);
+	UpdateStats();
+}
+
+void UEffectPoolSubsystem::PruneActiveComponents(FParticleComponentPool& Pool)
+{
+	for (int32 Index = Pool.ActiveComponents.Num() - 1; Index >= 0; --Index)
+	{
+		UParticleSystemComponent* Component = Pool.ActiveComponents[Index];
+
+		if (IsValid(Component) && Component->IsActive())
+		{
+			continue;
+		}
+
+		// Looping systems deactivated elsewhere and destroyed components never call the finished callback
+		Pool.ActiveComponents.RemoveAt(Index, 1, false);
+
+		if (IsValid(Component))
+		{
+			Pool.FreeComponents.Add(Component);
+		}
+	}
+}
+
+void UEffectPoolSubsystem::PruneActiveComponents(FAudioComponentPool& Pool)
+{
+	for (int32 Index = Pool.ActiveComponents.Num() - 1; Index >= 0; --Index)
+	{
+		UAudioComponent* Component = Pool.ActiveComponents[Index];
+
+		if (IsValid(Component) && Component->IsPlaying())
+		{
+			continue;
+		}
+
+		Pool.ActiveComponents.RemoveAt(Index, 1, false);
+
+		if (IsValid(Component))
+		{
+			Pool.FreeComponents.Add(Component);
+		}
+	}
+}
+
+void UEffectPoolSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_EffectComponentsActive, GetActiveComponentsNumber());
+	SET_DWORD_STAT(STAT_EffectComponentsFree, GetFreeComponentsNumber());
+	SET_DWORD_STAT(STAT_EffectAllocationsSaved, SavedAllocationsNumber);
+}
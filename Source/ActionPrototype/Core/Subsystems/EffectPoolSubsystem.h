@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EffectPoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+class USoundBase;
+class UAudioComponent;
+
+USTRUCT()
+struct FParticleComponentPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> FreeComponents{};
+	/** Sorted from the oldest. */
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> ActiveComponents{};
+};
+
+USTRUCT()
+struct FAudioComponentPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UAudioComponent*> FreeComponents{};
+	/** Sorted from the oldest. */
+	UPROPERTY()
+	TArray<UAudioComponent*> ActiveComponents{};
+};
+
+/**
+ * Plays one-shot particle systems and sounds on reused components.
+ * Limits the number of simultaneous instances of every effect by restarting the oldest one and culls effects far
+ * from the player's view point.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UEffectPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Plays the given particle system at the given location, the oldest instance is reused over the concurrency limit.
+	 * @return false if the effect was culled;
+	 */
+	UFUNCTION(BlueprintCallable, Category="Effect Pool")
+	bool PlayEmitterAtLocation(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation);
+	/** Plays the given sound at the given location, the oldest instance is reused over the concurrency limit.
+	 * @return false if the sound was culled;
+	 */
+	UFUNCTION(BlueprintCallable, Category="Effect Pool")
+	bool PlaySoundAtLocation(USoundBase* Sound, const FVector& Location);
+	/** Plays particles and sound at the same location, any of them can be null. */
+	UFUNCTION(BlueprintCallable, Category="Effect Pool")
+	void PlayEffectsAtLocation(UParticleSystem* Template, USoundBase* Sound, const FVector& Location);
+
+	UFUNCTION(BlueprintPure, Category="Effect Pool")
+	int32 GetActiveComponentsNumber() const;
+	UFUNCTION(BlueprintPure, Category="Effect Pool")
+	int32 GetFreeComponentsNumber() const;
+	/** Returns how many times an effect was played on a reused component instead of a new one. */
+	UFUNCTION(BlueprintPure, Category="Effect Pool")
+	FORCEINLINE int32 GetSavedAllocationsNumber() const { return SavedAllocationsNumber; }
+
+	/** Maximum number of simultaneous instances of the same particle system or sound. */
+	UPROPERTY(Config)
+	int32 MaxConcurrentPerEffect{8};
+	/** Effects further than this distance from the player's view point aren't played. If == 0.0 culling is disabled. */
+	UPROPERTY(Config)
+	float CullDistance{6000.f};
+
+private:
+	UPROPERTY()
+	TMap<UParticleSystem*, FParticleComponentPool> ParticlePools{};
+	UPROPERTY()
+	TMap<USoundBase*, FAudioComponentPool> AudioPools{};
+
+	int32 SavedAllocationsNumber{0};
+
+	bool IsCulled(const FVector& Location) const;
+	UParticleSystemComponent* CreateParticleComponent(UParticleSystem* Template);
+	UAudioComponent* CreateAudioComponent(USoundBase* Sound);
+	UFUNCTION()
+	void ReleaseParticleComponent(UParticleSystemComponent* Component);
+	void ReleaseAudioComponent(UAudioComponent* Component);
+	/** Moves finished components to the free ones and drops destroyed components. */
+	static void PruneActiveComponents(FParticleComponentPool& Pool);
+	static void PruneActiveComponents(FAudioComponentPool& Pool);
+	void UpdateStats() const;
+};
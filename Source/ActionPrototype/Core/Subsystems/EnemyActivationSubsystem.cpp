@@ -0,0 +1,229 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyActivationSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Awake Enemies"), STAT_AwakeEnemies, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Enemies"), STAT_DormantEnemies, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Enemy Activation Update"), STAT_EnemyActivationUpdate, STATGROUP_ActionPrototype);
+
+static TAutoConsoleVariable<int32> CVarEnemyActivationDebug(
+	TEXT("ap.EnemyActivation.Debug"),
+	0,
+	TEXT("Draws the enemy activation grid. 0 - disabled, 1 - enabled."),
+	ECVF_Cheat);
+
+void UEnemyActivationSubsystem::Deinitialize()
+{
+	AwakeEnemies.Empty();
+	DormantCells.Empty();
+	DormantEnemyCells.Empty();
+	SET_DWORD_STAT(STAT_AwakeEnemies, 0);
+	SET_DWORD_STAT(STAT_DormantEnemies, 0);
+	Super::Deinitialize();
+}
+
+void UEnemyActivationSubsystem::Tick(float DeltaTime)
+{
+	AP_SCOPE_BUDGET(AI, EnemyActivationUpdate, this);
+	SET_DWORD_STAT(STAT_AwakeEnemies, AwakeEnemies.Num());
+	SET_DWORD_STAT(STAT_DormantEnemies, DormantEnemyCells.Num());
+	CSV_CUSTOM_STAT(GameplayAI, AwakeEnemies, AwakeEnemies.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(GameplayAI, DormantEnemies, DormantEnemyCells.Num(), ECsvCustomStatOp::Set);
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (PlayerPawn == nullptr)
+	{
+		return;
+	}
+
+	PlayerCell = GetCell(PlayerPawn->GetActorLocation());
+	WakeEnemiesAround(PlayerCell);
+	PutFarEnemiesToSleep(PlayerCell);
+
+	if (CVarEnemyActivationDebug.GetValueOnGameThread() > 0)
+	{
+		DrawDebugCells();
+	}
+}
+
+TStatId UEnemyActivationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyActivationSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UEnemyActivationSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+UWorld* UEnemyActivationSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UEnemyActivationSubsystem::RegisterEnemy(AEnemyCharacter* Enemy, const bool bStartDormant)
+{
+	if (Enemy == nullptr || AwakeEnemies.Contains(Enemy) || DormantEnemyCells.Contains(Enemy))
+	{
+		return;
+	}
+
+	AwakeEnemies.Add(Enemy);
+
+	if (bStartDormant)
+	{
+		PutEnemyToSleep(Enemy);
+	}
+}
+
+void UEnemyActivationSubsystem::UnregisterEnemy(AEnemyCharacter* Enemy)
+{
+	if (AwakeEnemies.RemoveSingleSwap(Enemy, false) > 0)
+	{
+		return;
+	}
+
+	FIntPoint Cell;
+
+	if (!DormantEnemyCells.RemoveAndCopyValue(Enemy, Cell))
+	{
+		return;
+	}
+
+	TArray<AEnemyCharacter*>* CellEnemies = DormantCells.Find(Cell);
+
+	if (CellEnemies != nullptr)
+	{
+		CellEnemies->RemoveSingleSwap(Enemy, false);
+	}
+}
+
+FIntPoint UEnemyActivationSubsystem::GetCell(const FVector& Location) const
+{
+	const float Size = FMath::Max(CellSize, 1.f);
+	return FIntPoint(FMath::FloorToInt(Location.X / Size), FMath::FloorToInt(Location.Y / Size));
+}
+
+int32 UEnemyActivationSubsystem::GetCellsDistance(const FIntPoint& CellA, const FIntPoint& CellB)
+{
+	return FMath::Max(FMath::Abs(CellA.X - CellB.X), FMath::Abs(CellA.Y - CellB.Y));
+}
+
+void UEnemyActivationSubsystem::WakeEnemiesAround(const FIntPoint& Cell)
+{
+	for (int32 CellX = Cell.X - WakeCellsRadius; CellX <= Cell.X + WakeCellsRadius; ++CellX)
+	{
+		for (int32 CellY = Cell.Y - WakeCellsRadius; CellY <= Cell.Y + WakeCellsRadius; ++CellY)
+		{
+			TArray<AEnemyCharacter*>* CellEnemies = DormantCells.Find(FIntPoint(CellX, CellY));
+
+			if (CellEnemies == nullptr)
+			{
+				continue;
+			}
+
+			while (CellEnemies->Num() > 0)
+			{
+				AEnemyCharacter* Enemy = CellEnemies->Pop(false);
+				DormantEnemyCells.Remove(Enemy);
+				WakeEnemy(Enemy);
+			}
+		}
+	}
+}
+
+void UEnemyActivationSubsystem::PutFarEnemiesToSleep(const FIntPoint& Cell)
+{
+	const int32 SleepRadius = FMath::Max(SleepCellsRadius, WakeCellsRadius + 1);
+
+	for (int32 Index = AwakeEnemies.Num() - 1; Index >= 0; --Index)
+	{
+		AEnemyCharacter* Enemy = AwakeEnemies[Index];
+
+		if (Enemy == nullptr)
+		{
+			AwakeEnemies.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		if (GetCellsDistance(GetCell(Enemy->GetActorLocation()), Cell) > SleepRadius)
+		{
+			PutEnemyToSleep(Enemy);
+		}
+	}
+}
+
+void UEnemyActivationSubsystem::WakeEnemy(AEnemyCharacter* Enemy)
+{
+	if (Enemy == nullptr)
+	{
+		return;
+	}
+
+	AwakeEnemies.Add(Enemy);
+	Enemy->ExitDormancy();
+	OnEnemyWokeUp.Broadcast(Enemy);
+}
+
+void UEnemyActivationSubsystem::PutEnemyToSleep(AEnemyCharacter* Enemy)
+{
+	AwakeEnemies.RemoveSingleSwap(Enemy, false);
+	const FIntPoint Cell = GetCell(Enemy->GetActorLocation());
+	DormantCells.FindOrAdd(Cell).Add(Enemy);
+	DormantEnemyCells.Add(Enemy, Cell);
+	Enemy->EnterDormancy();
+	OnEnemyFellAsleep.Broadcast(Enemy);
+}
+
+void UEnemyActivationSubsystem::DrawDebugCells() const
+{
+#if ENABLE_DRAW_DEBUG
+	const UWorld* World = GetWorld();
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	const float DrawHeight = PlayerPawn != nullptr ? PlayerPawn->GetActorLocation().Z : 0.f;
+	const FVector CellExtent = FVector(CellSize * 0.5f, CellSize * 0.5f, 10.f);
+
+	auto GetCellCenter = [this, DrawHeight](const FIntPoint& Cell)
+	{
+		return FVector((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, DrawHeight);
+	};
+
+	for (int32 CellX = PlayerCell.X - WakeCellsRadius; CellX <= PlayerCell.X + WakeCellsRadius; ++CellX)
+	{
+		for (int32 CellY = PlayerCell.Y - WakeCellsRadius; CellY <= PlayerCell.Y + WakeCellsRadius; ++CellY)
+		{
+			DrawDebugBox(World, GetCellCenter(FIntPoint(CellX, CellY)), CellExtent, FColor::Green);
+		}
+	}
+
+	for (const TPair<FIntPoint, TArray<AEnemyCharacter*>>& Cell : DormantCells)
+	{
+		if (Cell.Value.Num() > 0)
+		{
+			DrawDebugBox(World, GetCellCenter(Cell.Key), CellExtent, FColor::Red);
+		}
+	}
+
+	for (const AEnemyCharacter* Enemy : AwakeEnemies)
+	{
+		if (Enemy != nullptr)
+		{
+			DrawDebugSphere(World, Enemy->GetActorLocation(), 64.f, 8, FColor::Green);
+		}
+	}
+
+	for (const TPair<AEnemyCharacter*, FIntPoint>& Enemy : DormantEnemyCells)
+	{
+		DrawDebugSphere(World, Enemy.Key->GetActorLocation(), 64.f, 8, FColor::Red);
+	}
+#endif
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyActivationSubsystem.generated.h"
+
+class AEnemyCharacter;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyWokeUp, AEnemyCharacter*, Enemy);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyFellAsleep, AEnemyCharacter*, Enemy);
+
+/**
+ * Keeps dormant enemies in a 2D grid and wakes them up when the player enters their cell or neighbour cells.
+ * Awake enemies fall asleep again only when the player is further than SleepCellsRadius, which prevents thrashing
+ * on cell borders.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UEnemyActivationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** Starts tracking the given enemy.
+	 * @param bStartDormant - determines if the enemy is put to sleep immediately;
+	 */
+	void RegisterEnemy(AEnemyCharacter* Enemy, const bool bStartDormant);
+	/** Stops tracking the given enemy, its dormancy state isn't changed. */
+	void UnregisterEnemy(AEnemyCharacter* Enemy);
+
+	UFUNCTION(BlueprintPure, Category="Enemy Activation")
+	FORCEINLINE int32 GetAwakeEnemiesNumber() const { return AwakeEnemies.Num(); }
+	UFUNCTION(BlueprintPure, Category="Enemy Activation")
+	FORCEINLINE int32 GetDormantEnemiesNumber() const { return DormantEnemyCells.Num(); }
+
+	/** Calls when a dormant enemy wakes up. */
+	UPROPERTY(BlueprintAssignable, Category="Enemy Activation|Delegates")
+	FOnEnemyWokeUp OnEnemyWokeUp;
+	/** Calls when an awake enemy falls asleep. */
+	UPROPERTY(BlueprintAssignable, Category="Enemy Activation|Delegates")
+	FOnEnemyFellAsleep OnEnemyFellAsleep;
+
+	/** Size of a grid cell in world units. */
+	UPROPERTY(Config)
+	float CellSize{2048.f};
+	/** Dormant enemies in cells not further than this number of cells from the player's cell wake up. */
+	UPROPERTY(Config)
+	int32 WakeCellsRadius{1};
+	/** Awake enemies in cells further than this number of cells from the player's cell fall asleep. */
+	UPROPERTY(Config)
+	int32 SleepCellsRadius{2};
+
+private:
+	UPROPERTY()
+	TArray<AEnemyCharacter*> AwakeEnemies{};
+	TMap<FIntPoint, TArray<AEnemyCharacter*>> DormantCells{};
+	TMap<AEnemyCharacter*, FIntPoint> DormantEnemyCells{};
+	/** Cell of the player during the previous update. */
+	FIntPoint PlayerCell{TNumericLimits<int32>::Max(), TNumericLimits<int32>::Max()};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	static int32 GetCellsDistance(const FIntPoint& CellA, const FIntPoint& CellB);
+	void WakeEnemiesAround(const FIntPoint& Cell);
+	void PutFarEnemiesToSleep(const FIntPoint& Cell);
+	void WakeEnemy(AEnemyCharacter* Enemy);
+	void PutEnemyToSleep(AEnemyCharacter* Enemy);
+	void DrawDebugCells() const;
+};
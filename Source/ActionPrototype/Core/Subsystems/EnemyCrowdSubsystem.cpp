@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyCrowdSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Enemies"), STAT_CrowdEnemies, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Promoted Enemies"), STAT_CrowdPromotedEnemies, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Enemy Crowd Simulate"), STAT_EnemyCrowdSimulate, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Enemy Crowd LOD"), STAT_EnemyCrowdLod, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Crowd Enemy Promotion"), STAT_CrowdEnemyPromotion, STATGROUP_ActionPrototype);
+
+void UEnemyCrowdSubsystem::Deinitialize()
+{
+	Crowd.Empty();
+	EnemyClasses.Empty();
+	PromotedEnemiesNumber = 0;
+	SET_DWORD_STAT(STAT_CrowdEnemies, 0);
+	SET_DWORD_STAT(STAT_CrowdPromotedEnemies, 0);
+	Super::Deinitialize();
+}
+
+void UEnemyCrowdSubsystem::Tick(float DeltaTime)
+{
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (PlayerPawn == nullptr || Crowd.Num() == 0)
+	{
+		return;
+	}
+
+	SyncPromotedEnemies();
+
+	{
+		AP_SCOPE_BUDGET(AI, EnemyCrowdSimulate, this);
+		Crowd.Simulate(PlayerPawn->GetActorLocation(), DeltaTime, MoveSpeed, SimulationTasksNumber);
+	}
+
+	{
+		AP_SCOPE_BUDGET(AI, EnemyCrowdLod, this);
+		PromotionCandidates.Reset();
+		DemotionCandidates.Reset();
+		Crowd.CollectLodChanges(PromoteDistance, DemoteDistance, PromotionCandidates, DemotionCandidates);
+
+		for (const int32 Index : DemotionCandidates)
+		{
+			DemoteEnemy(Index);
+		}
+
+		const int32 PromotionsNumber = FMath::Min(
+												  MaxPromotionsPerFrame,
+												  MaxPromotedEnemies - PromotedEnemiesNumber
+												 );
+
+		if (PromotionsNumber > 0 && PromotionCandidates.Num() > 0)
+		{
+			PromotionCandidates.Sort(
+									 [this](const int32 IndexA, const int32 IndexB)
+									 {
+										 return Crowd.DistancesSquared[IndexA] < Crowd.DistancesSquared[IndexB];
+									 }
+									);
+
+			for (int32 Candidate = 0; Candidate < FMath::Min(PromotionsNumber, PromotionCandidates.Num()); ++Candidate)
+			{
+				PromoteEnemy(PromotionCandidates[Candidate]);
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_CrowdEnemies, Crowd.Num());
+	SET_DWORD_STAT(STAT_CrowdPromotedEnemies, PromotedEnemiesNumber);
+	CSV_CUSTOM_STAT(GameplayAI, CrowdEnemies, Crowd.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(GameplayAI, CrowdPromotedEnemies, PromotedEnemiesNumber, ECsvCustomStatOp::Set);
+}
+
+TStatId UEnemyCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyCrowdSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UEnemyCrowdSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+UWorld* UEnemyCrowdSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UEnemyCrowdSubsystem::AddEnemy(const TSubclassOf<AEnemyCharacter> EnemyClass, const FTransform& Transform)
+{
+	if (EnemyClass == nullptr)
+	{
+		return;
+	}
+
+	const AEnemyCharacter* DefaultEnemy = EnemyClass->GetDefaultObject<AEnemyCharacter>();
+	const int32 ClassIndex = EnemyClasses.AddUnique(EnemyClass);
+	Crowd.Add(
+			  Transform,
+			  DefaultEnemy->InitialState,
+			  DefaultEnemy->GetMaxHealth(),
+			  DefaultEnemy->AggroDistance,
+			  DefaultEnemy->AttackRadius,
+			  ClassIndex
+			 );
+}
+
+void UEnemyCrowdSubsystem::SyncPromotedEnemies()
+{
+	PromotedEnemiesNumber = 0;
+
+	for (int32 Index = Crowd.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Crowd.IsPromoted(Index))
+		{
+			continue;
+		}
+
+		const AEnemyCharacter* Enemy = Crowd.Actors[Index].Get();
+
+		if (Enemy == nullptr || Enemy->GetCurrentHealth() <= 0.f)
+		{
+			Crowd.RemoveAtSwap(Index);
+			continue;
+		}
+
+		Crowd.Transforms[Index] = Enemy->GetActorTransform();
+		Crowd.States[Index] = Enemy->GetCurrentState();
+		Crowd.Healths[Index] = Enemy->GetCurrentHealth();
+		++PromotedEnemiesNumber;
+	}
+}
+
+bool UEnemyCrowdSubsystem::PromoteEnemy(const int32 Index)
+{
+	AP_SCOPE_BUDGET(Spawning, CrowdEnemyPromotion, this);
+	AP_LLM_SCOPE(Enemies);
+
+	const TSubclassOf<AEnemyCharacter> EnemyClass = EnemyClasses[Crowd.ClassIndices[Index]];
+	UWorld* World = GetWorld();
+
+	if (EnemyClass == nullptr || World == nullptr)
+	{
+		return false;
+	}
+
+	const FTransform& Transform = Crowd.Transforms[Index];
+	AEnemyCharacter* Enemy = World->SpawnActorDeferred<AEnemyCharacter>(
+																		  EnemyClass,
+																		  Transform,
+																		  nullptr,
+																		  nullptr,
+																		  ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn
+																		 );
+
+	if (Enemy == nullptr)
+	{
+		return false;
+	}
+
+	Enemy->bStartDormant = false;
+	Enemy->FinishSpawning(Transform);
+	Enemy->RestoreHealth(Enemy->GetMaxHealth(), Crowd.Healths[Index]);
+	Enemy->RestoreState(Crowd.States[Index]);
+	Crowd.Actors[Index] = Enemy;
+	++PromotedEnemiesNumber;
+	return true;
+}
+
+void UEnemyCrowdSubsystem::DemoteEnemy(const int32 Index)
+{
+	AEnemyCharacter* Enemy = Crowd.Actors[Index].Get();
+	Crowd.Actors[Index].Reset();
+
+	if (Enemy == nullptr)
+	{
+		return;
+	}
+
+	Crowd.Transforms[Index] = Enemy->GetActorTransform();
+	Crowd.States[Index] = Enemy->GetCurrentState();
+	Crowd.Healths[Index] = Enemy->GetCurrentHealth();
+	Enemy->Destroy();
+	--PromotedEnemiesNumber;
+}
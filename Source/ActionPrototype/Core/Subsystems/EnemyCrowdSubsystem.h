@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "ActionPrototype/Core/AI/EnemyCrowd.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyCrowdSubsystem.generated.h"
+
+class AEnemyCharacter;
+
+/**
+ * Simulates large numbers of distant enemies as lightweight entities and promotes them to AEnemyCharacter actors
+ * near the player. Health and state are preserved across promotion and demotion.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UEnemyCrowdSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** Adds a lightweight enemy of the given class, its health and AI settings are taken from the class defaults. */
+	UFUNCTION(BlueprintCallable, Category="Enemy Crowd")
+	void AddEnemy(const TSubclassOf<AEnemyCharacter> EnemyClass, const FTransform& Transform);
+
+	UFUNCTION(BlueprintPure, Category="Enemy Crowd")
+	FORCEINLINE int32 GetEnemiesNumber() const { return Crowd.Num(); }
+	UFUNCTION(BlueprintPure, Category="Enemy Crowd")
+	FORCEINLINE int32 GetPromotedEnemiesNumber() const { return PromotedEnemiesNumber; }
+
+	/** Lightweight enemies closer than this distance to the player are promoted to actors. */
+	UPROPERTY(Config)
+	float PromoteDistance{4096.f};
+	/** Promoted enemies further than this distance from the player are demoted, must be greater than PromoteDistance. */
+	UPROPERTY(Config)
+	float DemoteDistance{6144.f};
+	UPROPERTY(Config)
+	int32 MaxPromotedEnemies{64};
+	/** Limits the number of actors spawned during one frame. */
+	UPROPERTY(Config)
+	int32 MaxPromotionsPerFrame{4};
+	/** Speed of chasing lightweight enemies. */
+	UPROPERTY(Config)
+	float MoveSpeed{300.f};
+	/** Number of parallel tasks lightweight enemies are simulated on. */
+	UPROPERTY(Config)
+	int32 SimulationTasksNumber{8};
+
+private:
+	FEnemyCrowd Crowd{};
+	/** Classes referenced by entities, keeps them from being collected. */
+	UPROPERTY()
+	TArray<TSubclassOf<AEnemyCharacter>> EnemyClasses{};
+	int32 PromotedEnemiesNumber{0};
+	TArray<int32> PromotionCandidates{};
+	TArray<int32> DemotionCandidates{};
+
+	/** Copies transform, state and health of promoted enemies and drops entities whose actors died or were destroyed. */
+	void SyncPromotedEnemies();
+	bool PromoteEnemy(const int32 Index);
+	void DemoteEnemy(const int32 Index);
+};
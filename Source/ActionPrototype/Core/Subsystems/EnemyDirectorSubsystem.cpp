@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyDirectorSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/EnemyCharacter.h"
+#include "ActionPrototype/Characters/PlayerCharacter.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Director Gather"), STAT_EnemyDirectorGather, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Enemy Director Classify"), STAT_EnemyDirectorClassify, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Enemy Director Decide"), STAT_EnemyDirectorDecide, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Enemy Director Apply"), STAT_EnemyDirectorApply, STATGROUP_ActionPrototype);
+
+void UEnemyDirectorSubsystem::Deinitialize()
+{
+	Enemies.Empty();
+	UpdatedEnemies.Empty();
+	Super::Deinitialize();
+}
+
+void UEnemyDirectorSubsystem::Tick(float DeltaTime)
+{
+	UpdatedEnemies.Reset();
+	RangeInputs.Reset();
+	DecisionInputs.Reset();
+
+	const APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+
+	if (PlayerCharacter == nullptr)
+	{
+		return;
+	}
+
+	FPlayerDecisionInput PlayerInput;
+	PlayerInput.Location = PlayerCharacter->GetActorLocation();
+	PlayerInput.bIsAlive = PlayerCharacter->GetCurrentHealth() > 0.f;
+
+	{
+		AP_SCOPE_BUDGET(AI, EnemyDirectorGather, this);
+
+		for (AEnemyCharacter* Enemy : Enemies)
+		{
+			if (Enemy != nullptr && Enemy->CanMakeDecision())
+			{
+				UpdatedEnemies.Add(Enemy);
+				RangeInputs.Add(Enemy->GetActorLocation(), Enemy->AggroDistance, Enemy->AttackRadius);
+			}
+		}
+	}
+
+	{
+		AP_SCOPE_BUDGET(AI, EnemyDirectorClassify, this);
+		EnemyClassification::Classify(RangeInputs, PlayerInput.Location, RangeBuckets);
+	}
+
+	{
+		AP_SCOPE_BUDGET(AI, EnemyDirectorGather, this);
+		DecisionInputs.SetNum(UpdatedEnemies.Num(), false);
+
+		for (int32 Index = 0; Index < UpdatedEnemies.Num(); ++Index)
+		{
+			if (UpdatedEnemies[Index] != nullptr)
+			{
+				UpdatedEnemies[Index]->GatherDecisionInput(PlayerInput, RangeBuckets[Index], DecisionInputs[Index]);
+			}
+		}
+	}
+
+	{
+		AP_SCOPE_BUDGET(AI, EnemyDirectorDecide, this);
+		const int32 TasksNumber = UpdatedEnemies.Num() >= MinEnemiesForParallelDecisions ? DecisionTasksNumber : 1;
+		EnemyDecision::DecideAll(DecisionInputs, PlayerInput, Commands, TasksNumber);
+	}
+
+	{
+		AP_SCOPE_BUDGET(AI, EnemyDirectorApply, this);
+
+		for (int32 Index = 0; Index < UpdatedEnemies.Num(); ++Index)
+		{
+			if (UpdatedEnemies[Index] != nullptr)
+			{
+				UpdatedEnemies[Index]->ApplyDecision(Commands[Index]);
+			}
+		}
+	}
+}
+
+TStatId UEnemyDirectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyDirectorSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UEnemyDirectorSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+UWorld* UEnemyDirectorSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UEnemyDirectorSubsystem::RegisterEnemy(AEnemyCharacter* Enemy)
+{
+	if (Enemy != nullptr)
+	{
+		Enemies.AddUnique(Enemy);
+	}
+}
+
+void UEnemyDirectorSubsystem::UnregisterEnemy(AEnemyCharacter* Enemy)
+{
+	Enemies.RemoveSingleSwap(Enemy, false);
+
+	// An enemy can be destroyed while decisions are applied, so indexes of the other enemies are kept
+	const int32 UpdatedIndex = UpdatedEnemies.Find(Enemy);
+
+	if (UpdatedIndex != INDEX_NONE)
+	{
+		UpdatedEnemies[UpdatedIndex] = nullptr;
+	}
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "ActionPrototype/Core/AI/EnemyClassification.h"
+#include "ActionPrototype/Core/AI/EnemyDecision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyDirectorSubsystem.generated.h"
+
+class AEnemyCharacter;
+
+/**
+ * Updates the state machines of all awake enemies once per frame.
+ * Ranges to the player are classified for all enemies at once, snapshots are gathered on the game thread,
+ * decisions are made in parallel and the resulting commands are applied on the game thread in one pass.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UEnemyDirectorSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	void RegisterEnemy(AEnemyCharacter* Enemy);
+	void UnregisterEnemy(AEnemyCharacter* Enemy);
+
+	UFUNCTION(BlueprintPure, Category="Enemy Director")
+	FORCEINLINE int32 GetEnemiesNumber() const { return Enemies.Num(); }
+	/** Returns the number of enemies updated during the last frame. */
+	UFUNCTION(BlueprintPure, Category="Enemy Director")
+	FORCEINLINE int32 GetUpdatedEnemiesNumber() const { return UpdatedEnemies.Num(); }
+
+	/** Number of parallel tasks decisions are split between. */
+	UPROPERTY(Config)
+	int32 DecisionTasksNumber{8};
+	/** If fewer enemies are updated, decisions are made on the game thread only. */
+	UPROPERTY(Config)
+	int32 MinEnemiesForParallelDecisions{64};
+
+private:
+	UPROPERTY()
+	TArray<AEnemyCharacter*> Enemies{};
+	/** Enemies updated during the current frame, indexes match RangeInputs, DecisionInputs and Commands.
+	 * Unregistered enemies are set to null until the next frame.
+	 */
+	UPROPERTY()
+	TArray<AEnemyCharacter*> UpdatedEnemies{};
+	FEnemyRangeInputs RangeInputs{};
+	TArray<EEnemyRangeBucket> RangeBuckets{};
+	TArray<FEnemyDecisionInput> DecisionInputs{};
+	TArray<FEnemyCommand> Commands{};
+};
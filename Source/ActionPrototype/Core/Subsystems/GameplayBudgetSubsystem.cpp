@@ -0,0 +1,268 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayBudgetSubsystem.h"
+
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gameplay Budget Hitches"), STAT_GameplayBudgetHitches, STATGROUP_ActionPrototype);
+
+static TAutoConsoleVariable<int32> CVarGameplayBudgets(
+	TEXT("ap.Budgets"),
+	1,
+	TEXT("Tracks gameplay frame budgets and reports hitches. 0 - disabled, 1 - enabled."),
+	ECVF_Default);
+
+#if CSV_PROFILER
+static int32 GetCsvCategoryIndex(const EGameplayBudget Category)
+{
+	switch (Category)
+	{
+		case EGameplayBudget::AI:
+			return CSV_CATEGORY_INDEX(GameplayAI);
+		case EGameplayBudget::Combat:
+			return CSV_CATEGORY_INDEX(GameplayCombat);
+		case EGameplayBudget::Resources:
+			return CSV_CATEGORY_INDEX(GameplayResources);
+		case EGameplayBudget::Interactables:
+			return CSV_CATEGORY_INDEX(GameplayInteractables);
+		default:
+			return CSV_CATEGORY_INDEX(GameplaySpawning);
+	}
+}
+#endif
+
+void UGameplayBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UGameplayBudgetSubsystem::HandleEndFrame);
+}
+
+void UGameplayBudgetSubsystem::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+	if (ReportWriter.IsValid())
+	{
+		ReportWriter->Close();
+		ReportWriter.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UGameplayBudgetSubsystem::BeginScope(const EGameplayBudget Category)
+{
+	++Frames[static_cast<int32>(Category)].OpenScopesNumber;
+}
+
+void UGameplayBudgetSubsystem::EndScope(
+	const EGameplayBudget Category,
+	const TCHAR* ScopeName,
+	const UObject* Context,
+	const double Seconds)
+{
+	FCategoryFrame& Frame = Frames[static_cast<int32>(Category)];
+	++Frame.ScopesNumber;
+
+	if (--Frame.OpenScopesNumber == 0)
+	{
+		Frame.Seconds += Seconds;
+	}
+
+	AddSlowestSample(Frame, ScopeName, Context, Seconds);
+}
+
+float UGameplayBudgetSubsystem::GetBudgetMs(const EGameplayBudget Category) const
+{
+	switch (Category)
+	{
+		case EGameplayBudget::AI:
+			return AIBudgetMs;
+		case EGameplayBudget::Combat:
+			return CombatBudgetMs;
+		case EGameplayBudget::Resources:
+			return ResourcesBudgetMs;
+		case EGameplayBudget::Interactables:
+			return InteractablesBudgetMs;
+		case EGameplayBudget::Spawning:
+			return SpawningBudgetMs;
+		default:
+			return 0.f;
+	}
+}
+
+void UGameplayBudgetSubsystem::HandleEndFrame()
+{
+	for (int32 Index = 0; Index < CategoriesNumber; ++Index)
+	{
+		FCategoryFrame& Frame = Frames[Index];
+		LastFrameMs[Index] = static_cast<float>(Frame.Seconds * 1000.0);
+
+		if (Frame.ScopesNumber == 0)
+		{
+			continue;
+		}
+
+		const EGameplayBudget Category = static_cast<EGameplayBudget>(Index);
+		const float FrameMs = static_cast<float>(Frame.Seconds * 1000.0);
+		const float BudgetMs = GetBudgetMs(Category);
+#if CSV_PROFILER
+		FCsvProfiler::RecordCustomStat("FrameMs", GetCsvCategoryIndex(Category), FrameMs, ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat("Scopes", GetCsvCategoryIndex(Category), Frame.ScopesNumber, ECsvCustomStatOp::Set);
+#endif
+
+		if (BudgetMs > 0.f && FrameMs > BudgetMs)
+		{
+			WriteHitchReport(Category, Frame, BudgetMs);
+		}
+
+		Frame.Seconds = 0.0;
+		Frame.ScopesNumber = 0;
+		Frame.SlowestSamples.Reset();
+	}
+}
+
+void UGameplayBudgetSubsystem::WriteHitchReport(
+	const EGameplayBudget Category,
+	const FCategoryFrame& Frame,
+	const float BudgetMs)
+{
+	++HitchesNumber;
+	INC_DWORD_STAT(STAT_GameplayBudgetHitches);
+
+	const FString CategoryName = StaticEnum<EGameplayBudget>()->GetNameStringByValue(static_cast<int64>(Category));
+	const float FrameMs = static_cast<float>(Frame.Seconds * 1000.0);
+	const FGameplayBudgetSample& Slowest = Frame.SlowestSamples[0];
+	UE_LOG(
+		   LogActionPrototype,
+		   Warning,
+		   TEXT("Gameplay hitch: %s took %.2f ms of %.2f ms in %d scopes, the slowest is %s of %s (%s) %.2f ms."),
+		   *CategoryName,
+		   FrameMs,
+		   BudgetMs,
+		   Frame.ScopesNumber,
+		   Slowest.ScopeName,
+		   *Slowest.ObjectName.ToString(),
+		   *Slowest.ClassName.ToString(),
+		   Slowest.Seconds * 1000.0
+		  );
+	CSV_EVENT_GLOBAL(TEXT("%s hitch %.2fms %s"), *CategoryName, FrameMs, *Slowest.ObjectName.ToString());
+
+	if (!ReportWriter.IsValid())
+	{
+		const FString ReportPath = FPaths::ProfilingDir() / FString::Printf(
+			 TEXT("GameplayHitches_%s.csv"),
+			 *FDateTime::Now().ToString()
+			);
+		ReportWriter.Reset(IFileManager::Get().CreateFileWriter(*ReportPath));
+
+		if (!ReportWriter.IsValid())
+		{
+			return;
+		}
+
+		FTCHARToUTF8 Header{TEXT("Frame,Time,Category,CategoryMs,BudgetMs,Scopes,Rank,Scope,Object,Class,ScopeMs\n")};
+		ReportWriter->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+	}
+
+	const UWorld* World = GetWorld();
+	const float Time = World != nullptr ? World->GetTimeSeconds() : 0.f;
+
+	for (int32 Rank = 0; Rank < Frame.SlowestSamples.Num(); ++Rank)
+	{
+		const FGameplayBudgetSample& Sample = Frame.SlowestSamples[Rank];
+		FTCHARToUTF8 Line{
+			*FString::Printf(
+							 TEXT("%llu,%.3f,%s,%.3f,%.3f,%d,%d,%s,%s,%s,%.3f\n"),
+							 GFrameCounter,
+							 Time,
+							 *CategoryName,
+							 FrameMs,
+							 BudgetMs,
+							 Frame.ScopesNumber,
+							 Rank + 1,
+							 Sample.ScopeName,
+							 *Sample.ObjectName.ToString(),
+							 *Sample.ClassName.ToString(),
+							 Sample.Seconds * 1000.0
+							)
+		};
+		ReportWriter->Serialize(const_cast<ANSICHAR*>(Line.Get()), Line.Length());
+	}
+
+	// Soak tests may end with a crash, so the reports are kept on disk right away
+	ReportWriter->Flush();
+}
+
+void UGameplayBudgetSubsystem::AddSlowestSample(
+	FCategoryFrame& Frame,
+	const TCHAR* ScopeName,
+	const UObject* Context,
+	const double Seconds)
+{
+	if (Frame.SlowestSamples.Num() == SlowestSamplesNumber && Frame.SlowestSamples.Last().Seconds >= Seconds)
+	{
+		return;
+	}
+
+	// Components are reported by their owners, e.g. the enemy whose health changed
+	const UActorComponent* Component = Cast<UActorComponent>(Context);
+	const UObject* ReportedObject = Component != nullptr && Component->GetOwner() != nullptr ? Component->GetOwner() : Context;
+	FGameplayBudgetSample Sample;
+	Sample.ScopeName = ScopeName;
+	Sample.ObjectName = ReportedObject != nullptr ? ReportedObject->GetFName() : NAME_None;
+	Sample.ClassName = ReportedObject != nullptr ? ReportedObject->GetClass()->GetFName() : NAME_None;
+	Sample.Seconds = Seconds;
+
+	int32 Index = 0;
+
+	while (Index < Frame.SlowestSamples.Num() && Frame.SlowestSamples[Index].Seconds >= Seconds)
+	{
+		++Index;
+	}
+
+	Frame.SlowestSamples.Insert(Sample, Index);
+
+	if (Frame.SlowestSamples.Num() > SlowestSamplesNumber)
+	{
+		Frame.SlowestSamples.Pop(false);
+	}
+}
+
+FGameplayBudgetScope::FGameplayBudgetScope(
+	const EGameplayBudget InCategory,
+	const TCHAR* InScopeName,
+	const UObject* InContext)
+	: Category{InCategory},
+	  ScopeName{InScopeName},
+	  Context{InContext}
+{
+	if (Context == nullptr || !IsInGameThread() || CVarGameplayBudgets.GetValueOnGameThread() == 0)
+	{
+		return;
+	}
+
+	const UWorld* World = Context->GetWorld();
+	Subsystem = World != nullptr ? World->GetSubsystem<UGameplayBudgetSubsystem>() : nullptr;
+
+	if (Subsystem != nullptr)
+	{
+		Subsystem->BeginScope(Category);
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+FGameplayBudgetScope::~FGameplayBudgetScope()
+{
+	if (Subsystem != nullptr)
+	{
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		Subsystem->EndScope(Category, ScopeName, Context, Seconds);
+	}
+}
@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionPrototype/ActionPrototype.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayBudgetSubsystem.generated.h"
+
+UENUM()
+enum class EGameplayBudget : uint8
+{
+	AI,
+	Combat,
+	Resources,
+	Interactables,
+	Spawning,
+	Max UMETA(Hidden)
+};
+
+/** One of the slowest scopes of a category in the current frame. */
+struct FGameplayBudgetSample
+{
+	const TCHAR* ScopeName{nullptr};
+	FName ObjectName{NAME_None};
+	FName ClassName{NAME_None};
+	double Seconds{0.0};
+};
+
+/**
+ * Sums the time gameplay scopes spend per category every frame and reports frames over the configured budgets.
+ * A hitch report names the slowest objects of the category and goes to the log, to the CSV profiler capture as an
+ * event and to Saved/Profiling/GameplayHitches_<Time>.csv, so soak tests are analyzed without the editor.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UGameplayBudgetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void BeginScope(const EGameplayBudget Category);
+	/** Adds the scope to the frame of its category, the time of nested scopes of the same category isn't summed twice. */
+	void EndScope(const EGameplayBudget Category, const TCHAR* ScopeName, const UObject* Context, const double Seconds);
+
+	float GetBudgetMs(const EGameplayBudget Category) const;
+	/** Time the category took in the last finished frame. */
+	FORCEINLINE float GetLastFrameMs(const EGameplayBudget Category) const { return LastFrameMs[static_cast<int32>(Category)]; }
+	FORCEINLINE int32 GetHitchesNumber() const { return HitchesNumber; }
+
+private:
+	static constexpr int32 SlowestSamplesNumber{3};
+	static constexpr int32 CategoriesNumber{static_cast<int32>(EGameplayBudget::Max)};
+
+	struct FCategoryFrame
+	{
+		double Seconds{0.0};
+		int32 ScopesNumber{0};
+		int32 OpenScopesNumber{0};
+		/** Sorted from the slowest. */
+		TArray<FGameplayBudgetSample, TInlineAllocator<SlowestSamplesNumber>> SlowestSamples{};
+	};
+
+	/** Budgets in milliseconds per frame, 0 disables the report of the category. */
+	UPROPERTY(Config)
+	float AIBudgetMs{2.f};
+	UPROPERTY(Config)
+	float CombatBudgetMs{1.f};
+	UPROPERTY(Config)
+	float ResourcesBudgetMs{0.5f};
+	UPROPERTY(Config)
+	float InteractablesBudgetMs{1.f};
+	UPROPERTY(Config)
+	float SpawningBudgetMs{2.f};
+
+	FCategoryFrame Frames[CategoriesNumber]{};
+	float LastFrameMs[CategoriesNumber]{};
+	int32 HitchesNumber{0};
+	TUniquePtr<FArchive> ReportWriter{};
+	FDelegateHandle EndFrameHandle{};
+
+	void HandleEndFrame();
+	void WriteHitchReport(const EGameplayBudget Category, const FCategoryFrame& Frame, const float BudgetMs);
+	static void AddSlowestSample(FCategoryFrame& Frame, const TCHAR* ScopeName, const UObject* Context, const double Seconds);
+};
+
+/** Times a gameplay scope for the budget of its category. */
+class ACTIONPROTOTYPE_API FGameplayBudgetScope
+{
+public:
+	FGameplayBudgetScope(const EGameplayBudget InCategory, const TCHAR* InScopeName, const UObject* InContext);
+	~FGameplayBudgetScope();
+
+private:
+	UGameplayBudgetSubsystem* Subsystem{nullptr};
+	EGameplayBudget Category{EGameplayBudget::AI};
+	const TCHAR* ScopeName{nullptr};
+	const UObject* Context{nullptr};
+	uint64 StartCycles{0};
+};
+
+/**
+ * Cycle counter STAT_<Name> of a gameplay category, also recorded by the CSV profiler with the number of calls
+ * per frame and counted towards the frame budget of the category. The context object is named in hitch reports.
+ */
+#if !UE_BUILD_SHIPPING
+#define AP_SCOPE_BUDGET(Category, Name, Context) \
+	AP_SCOPE_CYCLE_COUNTER(STAT_##Name); \
+	CSV_SCOPED_TIMING_STAT(Gameplay##Category, Name); \
+	CSV_CUSTOM_STAT(Gameplay##Category, Name##Calls, 1, ECsvCustomStatOp::Accumulate); \
+	FGameplayBudgetScope ANONYMOUS_VARIABLE(GameplayBudgetScope){EGameplayBudget::Category, TEXT(#Name), Context}
+#else
+#define AP_SCOPE_BUDGET(Category, Name, Context) AP_SCOPE_CYCLE_COUNTER(STAT_##Name)
+#endif
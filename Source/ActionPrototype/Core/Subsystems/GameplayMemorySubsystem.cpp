@@ -0,0 +1,230 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayMemorySubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gameplay Memory Sample"), STAT_GameplayMemorySample, STATGROUP_ActionPrototype);
+
+static TAutoConsoleVariable<int32> CVarSampleSpawnWaves(
+	TEXT("ap.Memory.SampleSpawnWaves"),
+	0,
+	TEXT("Samples gameplay classes after every spawn wave to catch peaks. 0 - disabled, 1 - enabled."),
+	ECVF_Default);
+
+void UGameplayMemorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UGameplayMemorySubsystem::SampleTags);
+}
+
+void UGameplayMemorySubsystem::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	ClassEntries.Empty();
+	GameplayClasses.Empty();
+	Super::Deinitialize();
+}
+
+void UGameplayMemorySubsystem::SampleClasses()
+{
+	AP_SCOPE_CYCLE_COUNTER(STAT_GameplayMemorySample);
+
+	const UWorld* World = GetWorld();
+
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	for (TPair<FName, FGameplayMemoryClassEntry>& Entry : ClassEntries)
+	{
+		Entry.Value.Instances = 0;
+		Entry.Value.Bytes = 0;
+	}
+
+	for (TObjectIterator<UObject> It{RF_ClassDefaultObject | RF_ArchetypeObject}; It; ++It)
+	{
+		UObject* Object = *It;
+
+		if (!IsGameplayClass(Object->GetClass()) || Object->GetWorld() != World)
+		{
+			continue;
+		}
+
+		FArchiveCountMem CountMem{Object};
+		FGameplayMemoryClassEntry& Entry = ClassEntries.FindOrAdd(Object->GetClass()->GetFName());
+		Entry.ClassName = Object->GetClass()->GetFName();
+		++Entry.Instances;
+		Entry.Bytes += CountMem.GetMax() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	for (TPair<FName, FGameplayMemoryClassEntry>& Entry : ClassEntries)
+	{
+		Entry.Value.PeakInstances = FMath::Max(Entry.Value.PeakInstances, Entry.Value.Instances);
+		Entry.Value.PeakBytes = FMath::Max(Entry.Value.PeakBytes, Entry.Value.Bytes);
+	}
+}
+
+void UGameplayMemorySubsystem::HandleSpawnWave()
+{
+	if (CVarSampleSpawnWaves.GetValueOnGameThread() != 0)
+	{
+		SampleClasses();
+	}
+}
+
+void UGameplayMemorySubsystem::LogReport() const
+{
+	const TArray<FGameplayMemoryClassEntry> Entries = GetClassEntries();
+	int32 TotalInstances = 0;
+	SIZE_T TotalBytes = 0;
+
+	for (const FGameplayMemoryClassEntry& Entry : Entries)
+	{
+		UE_LOG(
+			   LogActionPrototype,
+			   Log,
+			   TEXT("%-40s instances: %5d (peak %5d), memory: %9.1f KB (peak %9.1f KB)"),
+			   *Entry.ClassName.ToString(),
+			   Entry.Instances,
+			   Entry.PeakInstances,
+			   Entry.Bytes / 1024.f,
+			   Entry.PeakBytes / 1024.f
+			  );
+		TotalInstances += Entry.Instances;
+		TotalBytes += Entry.Bytes;
+	}
+
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Gameplay objects: %d in %d classes, %.1f KB."),
+		   TotalInstances,
+		   Entries.Num(),
+		   TotalBytes / 1024.f
+		  );
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (FLowLevelMemTracker::IsEnabled())
+	{
+		for (int32 Index = 0; Index < TagsNumber; ++Index)
+		{
+			const EActionPrototypeLLMTag Tag = static_cast<EActionPrototypeLLMTag>(Index);
+			UE_LOG(
+				   LogActionPrototype,
+				   Log,
+				   TEXT("LLM %s: %.2f MB (peak %.2f MB)"),
+				   GetTagName(Tag),
+				   GetTagBytes(Tag) / (1024.0 * 1024.0),
+				   GetTagPeakBytes(Tag) / (1024.0 * 1024.0)
+				  );
+		}
+
+		return;
+	}
+#endif
+
+	UE_LOG(LogActionPrototype, Log, TEXT("LLM tags aren't tracked, start the game with -llm to see them."));
+}
+
+TArray<FGameplayMemoryClassEntry> UGameplayMemorySubsystem::GetClassEntries() const
+{
+	TArray<FGameplayMemoryClassEntry> Entries;
+	ClassEntries.GenerateValueArray(Entries);
+	Entries.Sort(
+				 [](const FGameplayMemoryClassEntry& First, const FGameplayMemoryClassEntry& Second)
+				 {
+					 return First.PeakBytes > Second.PeakBytes;
+				 }
+				);
+	return Entries;
+}
+
+int64 UGameplayMemorySubsystem::GetTagBytes(const EActionPrototypeLLMTag Tag) const
+{
+	return TagBytes[static_cast<int32>(Tag)];
+}
+
+int64 UGameplayMemorySubsystem::GetTagPeakBytes(const EActionPrototypeLLMTag Tag) const
+{
+	return TagPeakBytes[static_cast<int32>(Tag)];
+}
+
+const TCHAR* UGameplayMemorySubsystem::GetTagName(const EActionPrototypeLLMTag Tag)
+{
+	switch (Tag)
+	{
+		case EActionPrototypeLLMTag::Enemies:
+			return TEXT("Enemies");
+		case EActionPrototypeLLMTag::Pickups:
+			return TEXT("Pickups");
+		case EActionPrototypeLLMTag::Weapons:
+			return TEXT("Weapons");
+		case EActionPrototypeLLMTag::HUD:
+			return TEXT("HUD");
+		default:
+			return TEXT("Unknown");
+	}
+}
+
+bool UGameplayMemorySubsystem::IsGameplayClass(const UClass* Class)
+{
+	const bool* CachedResult = GameplayClasses.Find(Class);
+
+	if (CachedResult != nullptr)
+	{
+		return *CachedResult;
+	}
+
+	const UClass* NativeClass = Class;
+
+	while (NativeClass != nullptr && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	const bool bIsGameplayClass = NativeClass != nullptr && NativeClass->GetOutermost() == StaticClass()->GetOutermost();
+	GameplayClasses.Add(Class, bIsGameplayClass);
+	return bIsGameplayClass;
+}
+
+void UGameplayMemorySubsystem::SampleTags()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (!FLowLevelMemTracker::IsEnabled())
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < TagsNumber; ++Index)
+	{
+		const ELLMTag Tag = static_cast<ELLMTag>(static_cast<int32>(ELLMTag::ProjectTagStart) + Index);
+		TagBytes[Index] = FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, Tag);
+		TagPeakBytes[Index] = FMath::Max(TagPeakBytes[Index], TagBytes[Index]);
+	}
+#endif
+}
+
+static void ReportGameplayMemory(UWorld* World)
+{
+	UGameplayMemorySubsystem* GameplayMemory = World != nullptr ? World->GetSubsystem<UGameplayMemorySubsystem>() : nullptr;
+
+	if (GameplayMemory == nullptr)
+	{
+		return;
+	}
+
+	GameplayMemory->SampleClasses();
+	GameplayMemory->LogReport();
+}
+
+static FAutoConsoleCommandWithWorld GameplayMemoryReportCommand(
+	TEXT("ap.Memory.Report"),
+	TEXT("Logs instances and memory of gameplay classes with their peaks and the gameplay LLM tags."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&ReportGameplayMemory));
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionPrototype/ActionPrototype.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameplayMemorySubsystem.generated.h"
+
+/** Live instances and memory of a class of this module, or of its Blueprint subclass, in a world. */
+struct FGameplayMemoryClassEntry
+{
+	FName ClassName{NAME_None};
+	int32 Instances{0};
+	int32 PeakInstances{0};
+	/** Memory of the objects and their containers counted by serialization, plus the exclusive resource size. */
+	SIZE_T Bytes{0};
+	SIZE_T PeakBytes{0};
+};
+
+/**
+ * Accounts instances and memory of this module's actors, components and widgets per class and keeps the peaks,
+ * so pooling and lazy creation are measured. Samples are taken after spawn waves, on ap.Memory.Report and by
+ * the combat benchmark. LLM tags are sampled every frame when the game is started with -llm.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API UGameplayMemorySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Counts the objects of the world and updates the peaks. It walks all objects, so it isn't meant for every frame. */
+	void SampleClasses();
+	/** Samples classes after a spawn wave if ap.Memory.SampleSpawnWaves is enabled. */
+	void HandleSpawnWave();
+	/** Logs the last sample of every class sorted by memory and the LLM tags. */
+	void LogReport() const;
+
+	/** Returns entries of the last sample sorted by memory. */
+	TArray<FGameplayMemoryClassEntry> GetClassEntries() const;
+	/** Returns current bytes of the LLM tag, 0 if LLM isn't enabled. */
+	int64 GetTagBytes(const EActionPrototypeLLMTag Tag) const;
+	int64 GetTagPeakBytes(const EActionPrototypeLLMTag Tag) const;
+	static const TCHAR* GetTagName(const EActionPrototypeLLMTag Tag);
+
+private:
+	static constexpr int32 TagsNumber{static_cast<int32>(EActionPrototypeLLMTag::Max)};
+
+	TMap<FName, FGameplayMemoryClassEntry> ClassEntries{};
+	/**
+	 * Classes are checked once whether they derive from a native class of this module. Keys include the serial number,
+	 * so a class collected or reinstanced after a Blueprint compile isn't mistaken for one at the same address.
+	 */
+	TMap<FObjectKey, bool> GameplayClasses{};
+	int64 TagBytes[TagsNumber]{};
+	int64 TagPeakBytes[TagsNumber]{};
+	FDelegateHandle EndFrameHandle{};
+
+	bool IsGameplayClass(const UClass* Class);
+	void SampleTags();
+};
@@ -0,0 +1,255 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelTransitionSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/PlayerCharacter.h"
+#include "ActionPrototype/Core/Data/PlayerSnapshot.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/PackageName.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Player Snapshot Capture"), STAT_PlayerSnapshotCapture, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Player Snapshot Restore"), STAT_PlayerSnapshotRestore, STATGROUP_ActionPrototype);
+
+void ULevelTransitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(
+																				this,
+																				&ULevelTransitionSubsystem::HandlePostLoadMap
+																			   );
+}
+
+void ULevelTransitionSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	PreloadedPackage = nullptr;
+	PlayerSnapshotData.Empty();
+	Super::Deinitialize();
+}
+
+ULevelTransitionSubsystem* ULevelTransitionSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine != nullptr
+		                      ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		                      : nullptr;
+	const UGameInstance* GameInstance = World != nullptr ? World->GetGameInstance() : nullptr;
+	return GameInstance != nullptr ? GameInstance->GetSubsystem<ULevelTransitionSubsystem>() : nullptr;
+}
+
+void ULevelTransitionSubsystem::PreloadLevel(const FName LevelName)
+{
+	if (LevelName.IsNone() || LevelName == PreloadedLevelName)
+	{
+		return;
+	}
+
+	if (!FPackageName::IsValidLongPackageName(LevelName.ToString()))
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Level %s isn't a long package name, it can't be preloaded."), *LevelName.ToString());
+		return;
+	}
+
+	PreloadedLevelName = LevelName;
+	PreloadedPackage = nullptr;
+	bIsPreloading = true;
+	PreloadStartTime = FPlatformTime::Seconds();
+	LoadPackageAsync(
+					 LevelName.ToString(),
+					 FLoadPackageAsyncDelegate::CreateUObject(this, &ULevelTransitionSubsystem::HandlePackageLoaded)
+					);
+}
+
+void ULevelTransitionSubsystem::TransitionToLevel(const FName LevelName)
+{
+	if (LevelName.IsNone() || IsTransitionPending())
+	{
+		return;
+	}
+
+	TransitionStartTime = FPlatformTime::Seconds();
+
+	if (LevelName == PreloadedLevelName && bIsPreloading)
+	{
+		PendingLevelName = LevelName;
+		return;
+	}
+
+	OpenLevel(LevelName);
+}
+
+float ULevelTransitionSubsystem::GetLoadProgress(const FName LevelName) const
+{
+	if (LevelName.IsNone() || LevelName != PreloadedLevelName)
+	{
+		return 0.f;
+	}
+
+	if (!bIsPreloading)
+	{
+		return PreloadedPackage != nullptr ? 1.f : 0.f;
+	}
+
+	return FMath::Clamp(GetAsyncLoadPercentage(PreloadedLevelName) / 100.f, 0.f, 1.f);
+}
+
+bool ULevelTransitionSubsystem::IsLevelPreloaded(const FName LevelName) const
+{
+	return !LevelName.IsNone() && LevelName == PreloadedLevelName && PreloadedPackage != nullptr;
+}
+
+void ULevelTransitionSubsystem::CapturePlayerSnapshot()
+{
+	AP_SCOPE_CYCLE_COUNTER(STAT_PlayerSnapshotCapture);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+	PlayerSnapshotData.Reset();
+
+	if (PlayerCharacter == nullptr || PlayerCharacter->GetCurrentHealth() <= 0.f)
+	{
+		return;
+	}
+
+	FPlayerSnapshot Snapshot;
+	PlayerCharacter->WriteSnapshot(Snapshot);
+	FMemoryWriter Writer{PlayerSnapshotData};
+	Snapshot.Serialize(Writer);
+	CheckSnapshotBudget(TEXT("capture"), StartCycles);
+}
+
+void ULevelTransitionSubsystem::RestorePlayerSnapshot(APlayerCharacter* PlayerCharacter)
+{
+	if (PlayerCharacter == nullptr || PlayerSnapshotData.Num() == 0)
+	{
+		return;
+	}
+
+	AP_SCOPE_CYCLE_COUNTER(STAT_PlayerSnapshotRestore);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	FPlayerSnapshot Snapshot;
+	FMemoryReader Reader{PlayerSnapshotData};
+
+	if (Snapshot.Serialize(Reader))
+	{
+		PlayerCharacter->ApplySnapshot(Snapshot);
+	}
+	else
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Player snapshot has an unsupported version or is corrupted, it's discarded."));
+	}
+
+	PlayerSnapshotData.Empty();
+	CheckSnapshotBudget(TEXT("restore"), StartCycles);
+}
+
+void ULevelTransitionSubsystem::HandlePackageLoaded(
+	const FName& PackageName,
+	UPackage* LoadedPackage,
+	EAsyncLoadingResult::Type Result)
+{
+	if (PackageName != PreloadedLevelName)
+	{
+		return;
+	}
+
+	bIsPreloading = false;
+	PreloadDuration = static_cast<float>(FPlatformTime::Seconds() - PreloadStartTime);
+
+	if (Result == EAsyncLoadingResult::Succeeded)
+	{
+		// Referenced until the map is opened, so the package isn't collected in between
+		PreloadedPackage = LoadedPackage;
+		UE_LOG(LogActionPrototype, Log, TEXT("Level %s preloaded in %.3f s."), *PreloadedLevelName.ToString(), PreloadDuration);
+	}
+	else
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Failed to preload level %s."), *PreloadedLevelName.ToString());
+		// Cleared so the next preload request of the level tries again
+		PreloadedLevelName = NAME_None;
+	}
+
+	if (!PendingLevelName.IsNone())
+	{
+		const FName LevelName = PendingLevelName;
+		PendingLevelName = NAME_None;
+		OpenLevel(LevelName);
+	}
+}
+
+void ULevelTransitionSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	PreloadedPackage = nullptr;
+	PreloadedLevelName = NAME_None;
+	bIsPreloading = false;
+
+	if (LoadedWorld == nullptr || TransitionStartTime <= 0.0)
+	{
+		return;
+	}
+
+	LoadedWorld->GetTimerManager().SetTimerForNextTick(
+													   FTimerDelegate::CreateUObject(
+														   this,
+														   &ULevelTransitionSubsystem::HandleFirstFrame
+														  )
+													  );
+}
+
+void ULevelTransitionSubsystem::HandleFirstFrame()
+{
+	if (TransitionStartTime <= 0.0)
+	{
+		return;
+	}
+
+	LastTimeToInteractive = static_cast<float>(FPlatformTime::Seconds() - TransitionStartTime);
+	TransitionStartTime = 0.0;
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Level is interactive %.3f s after the transition request, preload took %.3f s."),
+		   LastTimeToInteractive,
+		   PreloadDuration
+		  );
+	PreloadDuration = 0.f;
+}
+
+void ULevelTransitionSubsystem::OpenLevel(const FName LevelName)
+{
+	UGameInstance* GameInstance = GetGameInstance();
+	UWorld* World = GameInstance != nullptr ? GameInstance->GetWorld() : nullptr;
+
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	AP_TRACE_EVENT(TEXT("Open level %s"), *LevelName.ToString());
+	CapturePlayerSnapshot();
+	UGameplayStatics::OpenLevel(World, LevelName);
+}
+
+void ULevelTransitionSubsystem::CheckSnapshotBudget(const TCHAR* Operation, const uint64 StartCycles) const
+{
+	const float ElapsedMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+
+	if (ElapsedMs > SnapshotBudgetMs)
+	{
+		UE_LOG(
+			   LogActionPrototype,
+			   Warning,
+			   TEXT("Player snapshot %s took %.3f ms, the budget is %.3f ms."),
+			   Operation,
+			   ElapsedMs,
+			   SnapshotBudgetMs
+			  );
+	}
+}
+
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+#include "LevelTransitionSubsystem.generated.h"
+
+class APlayerCharacter;
+
+/**
+ * Loads level packages in the background before a transition and opens them once they're resident,
+ * so the map load doesn't block on disk. Measures the time from a transition request to the first frame of the new level.
+ * Also carries a binary snapshot of the player over the transition.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API ULevelTransitionSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static ULevelTransitionSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Starts loading the package of the given level asynchronously, does nothing if it's already loading or loaded.
+	 * The level is given by its long package name, e.g. /Game/Maps/Level_1, so it isn't searched on disk.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Level Transition")
+	void PreloadLevel(const FName LevelName);
+	/** Opens the given level, waits for its package first if it's being preloaded. */
+	UFUNCTION(BlueprintCallable, Category="Level Transition")
+	void TransitionToLevel(const FName LevelName);
+
+	/** Returns the load progress of the given level in range [0, 1], 0 if it isn't preloaded. */
+	UFUNCTION(BlueprintPure, Category="Level Transition")
+	float GetLoadProgress(const FName LevelName) const;
+	UFUNCTION(BlueprintPure, Category="Level Transition")
+	bool IsLevelPreloaded(const FName LevelName) const;
+	UFUNCTION(BlueprintPure, Category="Level Transition")
+	FORCEINLINE bool IsTransitionPending() const { return !PendingLevelName.IsNone(); }
+	/** Seconds from the last transition request to the first frame of the opened level. */
+	UFUNCTION(BlueprintPure, Category="Level Transition")
+	FORCEINLINE float GetLastTimeToInteractive() const { return LastTimeToInteractive; }
+
+	/** Serializes the state of the first local player's character, it's restored when the next player character begins play. */
+	void CapturePlayerSnapshot();
+	/** Applies and discards the captured snapshot. */
+	void RestorePlayerSnapshot(APlayerCharacter* PlayerCharacter);
+	UFUNCTION(BlueprintPure, Category="Level Transition")
+	FORCEINLINE bool HasPlayerSnapshot() const { return PlayerSnapshotData.Num() > 0; }
+
+	/** Time in milliseconds capturing or restoring the snapshot may take before a warning is logged. */
+	UPROPERTY(Config)
+	float SnapshotBudgetMs{0.5f};
+
+private:
+	UPROPERTY()
+	UPackage* PreloadedPackage{nullptr};
+
+	/** Long package name of the preloaded level. */
+	FName PreloadedLevelName{NAME_None};
+	bool bIsPreloading{false};
+	double PreloadStartTime{0.0};
+	float PreloadDuration{0.f};
+
+	FName PendingLevelName{NAME_None};
+	double TransitionStartTime{0.0};
+	float LastTimeToInteractive{0.f};
+	FDelegateHandle PostLoadMapHandle{};
+	TArray<uint8> PlayerSnapshotData{};
+
+	void HandlePackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+	void HandleFirstFrame();
+	void OpenLevel(const FName LevelName);
+	void CheckSnapshotBudget(const TCHAR* Operation, const uint64 StartCycles) const;
+};
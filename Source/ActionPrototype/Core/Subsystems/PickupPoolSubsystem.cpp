@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PickupPoolSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Actors/Pickups/BasePickupItem.h"
+#include "ActionPrototype/Core/Subsystems/GameplayBudgetSubsystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Pickups Free"), STAT_PooledPickupsFree, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Pickups Active"), STAT_PooledPickupsActive, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Pickups Class High Water"), STAT_PooledPickupsClassHighWater, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Pickups Warmed Up"), STAT_PooledPickupsWarmedUp, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups Spawned"), STAT_PickupsSpawned, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups Reused"), STAT_PickupsReused, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Pooled Pickup Spawn"), STAT_PooledPickupSpawn, STATGROUP_ActionPrototype);
+
+void UPickupPoolSubsystem::Deinitialize()
+{
+	Pools.Empty();
+	UpdateStats();
+	Super::Deinitialize();
+}
+
+ABasePickupItem* UPickupPoolSubsystem::SpawnPickup(
+	const TSubclassOf<ABasePickupItem> PickupClass,
+	const FTransform& Transform)
+{
+	AP_SCOPE_BUDGET(Spawning, PooledPickupSpawn, this);
+
+	if (PickupClass == nullptr)
+	{
+		return {nullptr};
+	}
+
+	FPickupPool& Pool = Pools.FindOrAdd(PickupClass);
+	ABasePickupItem* Pickup{nullptr};
+
+	while (Pool.FreePickups.Num() > 0 && Pickup == nullptr)
+	{
+		Pickup = Pool.FreePickups.Pop(false);
+
+		if (!IsValid(Pickup))
+		{
+			Pickup = nullptr;
+		}
+	}
+
+	if (Pickup != nullptr)
+	{
+		Pickup->ActivatePickup(Transform);
+		INC_DWORD_STAT(STAT_PickupsReused);
+	}
+	else
+	{
+		Pickup = SpawnPickupActor(PickupClass, Transform);
+
+		if (Pickup == nullptr)
+		{
+			return {nullptr};
+		}
+
+		INC_DWORD_STAT(STAT_PickupsSpawned);
+	}
+
+	Pool.ActivePickups.Add(Pickup);
+	Pool.HighWaterMark = FMath::Max(Pool.HighWaterMark, Pool.ActivePickups.Num());
+	UpdateStats();
+	return Pickup;
+}
+
+void UPickupPoolSubsystem::ReleasePickup(ABasePickupItem* Pickup)
+{
+	if (!IsValid(Pickup))
+	{
+		return;
+	}
+
+	// Pickups placed in a level keep their identity for save games, so they're hidden instead of handed out as drops
+	if (Pickup->HasAnyFlags(RF_WasLoaded))
+	{
+		Pickup->DeactivatePickup();
+		return;
+	}
+
+	FPickupPool& Pool = Pools.FindOrAdd(Pickup->GetClass());
+	Pool.ActivePickups.Remove(Pickup);
+
+	if (Pool.FreePickups.Num() >= MaxFreePickupsPerClass)
+	{
+		Pickup->Destroy();
+	}
+	else
+	{
+		Pickup->DeactivatePickup();
+		Pool.FreePickups.Add(Pickup);
+	}
+
+	UpdateStats();
+}
+
+bool UPickupPoolSubsystem::ClaimPickup(ABasePickupItem* Pickup, const FTransform& Transform)
+{
+	if (!IsValid(Pickup))
+	{
+		return false;
+	}
+
+	FPickupPool* Pool = Pools.Find(Pickup->GetClass());
+
+	if (Pool == nullptr || Pool->FreePickups.RemoveSingleSwap(Pickup, false) == 0)
+	{
+		return false;
+	}
+
+	Pickup->ActivatePickup(Transform);
+	Pool->ActivePickups.Add(Pickup);
+	Pool->HighWaterMark = FMath::Max(Pool->HighWaterMark, Pool->ActivePickups.Num());
+	UpdateStats();
+	return true;
+}
+
+void UPickupPoolSubsystem::WarmupPool(const TSubclassOf<ABasePickupItem> PickupClass, const int32 Number)
+{
+	if (PickupClass == nullptr)
+	{
+		return;
+	}
+
+	FPickupPool& Pool = Pools.FindOrAdd(PickupClass);
+	const int32 TargetNumber = FMath::Min(Number, MaxFreePickupsPerClass);
+
+	while (Pool.FreePickups.Num() < TargetNumber)
+	{
+		ABasePickupItem* Pickup = SpawnPickupActor(PickupClass, FTransform::Identity);
+
+		if (Pickup == nullptr)
+		{
+			break;
+		}
+
+		Pickup->DeactivatePickup();
+		Pool.FreePickups.Add(Pickup);
+		INC_DWORD_STAT(STAT_PooledPickupsWarmedUp);
+	}
+
+	UpdateStats();
+}
+
+int32 UPickupPoolSubsystem::GetFreePickupsNumber(const TSubclassOf<ABasePickupItem> PickupClass) const
+{
+	const FPickupPool* Pool = Pools.Find(PickupClass);
+	return Pool != nullptr ? Pool->FreePickups.Num() : 0;
+}
+
+int32 UPickupPoolSubsystem::GetActivePickupsNumber(const TSubclassOf<ABasePickupItem> PickupClass) const
+{
+	const FPickupPool* Pool = Pools.Find(PickupClass);
+	return Pool != nullptr ? Pool->ActivePickups.Num() : 0;
+}
+
+int32 UPickupPoolSubsystem::GetHighWaterMark(const TSubclassOf<ABasePickupItem> PickupClass) const
+{
+	const FPickupPool* Pool = Pools.Find(PickupClass);
+	return Pool != nullptr ? Pool->HighWaterMark : 0;
+}
+
+ABasePickupItem* UPickupPoolSubsystem::SpawnPickupActor(UClass* PickupClass, const FTransform& Transform) const
+{
+	UWorld* World = GetWorld();
+
+	if (World == nullptr)
+	{
+		return {nullptr};
+	}
+
+	AP_LLM_SCOPE(Pickups);
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return World->SpawnActor<ABasePickupItem>(PickupClass, Transform, SpawnParameters);
+}
+
+void UPickupPoolSubsystem::UpdateStats() const
+{
+	int32 FreeNumber = 0;
+	int32 ActiveNumber = 0;
+	int32 ClassHighWaterMark = 0;
+
+	for (const TPair<UClass*, FPickupPool>& Pool : Pools)
+	{
+		FreeNumber += Pool.Value.FreePickups.Num();
+		ActiveNumber += Pool.Value.ActivePickups.Num();
+		ClassHighWaterMark = FMath::Max(ClassHighWaterMark, Pool.Value.HighWaterMark);
+	}
+
+	SET_DWORD_STAT(STAT_PooledPickupsFree, FreeNumber);
+	SET_DWORD_STAT(STAT_PooledPickupsActive, ActiveNumber);
+	SET_DWORD_STAT(STAT_PooledPickupsClassHighWater, ClassHighWaterMark);
+}
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupPoolSubsystem.generated.h"
+
+class ABasePickupItem;
+
+USTRUCT()
+struct FPickupPool
+{
+	GENERATED_BODY()
+
+	/** Deactivated pickups ready to be handed out. */
+	UPROPERTY()
+	TArray<ABasePickupItem*> FreePickups{};
+	/** Pickups handed out by the pool and not released yet. */
+	UPROPERTY()
+	TSet<ABasePickupItem*> ActivePickups{};
+	/** The biggest number of simultaneously active pickups. */
+	int32 HighWaterMark{0};
+};
+
+/**
+ * Keeps deactivated pickups per class and hands them out instead of spawning new actors.
+ * Only pickups spawned at runtime are pooled, released level pickups are just deactivated.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API UPickupPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Returns a pooled pickup of the given class moved to the given transform, or spawns a new one if the pool is empty. */
+	UFUNCTION(BlueprintCallable, Category="Pickup Pool")
+	ABasePickupItem* SpawnPickup(const TSubclassOf<ABasePickupItem> PickupClass, const FTransform& Transform);
+	/** Deactivates the given pickup and returns it to the pool if it was spawned at runtime. Destroys it if the pool is full. */
+	UFUNCTION(BlueprintCallable, Category="Pickup Pool")
+	void ReleasePickup(ABasePickupItem* Pickup);
+	/** Takes the given free pickup out of the pool and activates it at the given transform.
+	 * Returns false if the pickup isn't free.
+	 */
+	bool ClaimPickup(ABasePickupItem* Pickup, const FTransform& Transform);
+	/** Spawns deactivated pickups until the pool of the given class has the given number of free pickups. */
+	UFUNCTION(BlueprintCallable, Category="Pickup Pool")
+	void WarmupPool(const TSubclassOf<ABasePickupItem> PickupClass, const int32 Number);
+
+	UFUNCTION(BlueprintPure, Category="Pickup Pool")
+	int32 GetFreePickupsNumber(const TSubclassOf<ABasePickupItem> PickupClass) const;
+	UFUNCTION(BlueprintPure, Category="Pickup Pool")
+	int32 GetActivePickupsNumber(const TSubclassOf<ABasePickupItem> PickupClass) const;
+	UFUNCTION(BlueprintPure, Category="Pickup Pool")
+	int32 GetHighWaterMark(const TSubclassOf<ABasePickupItem> PickupClass) const;
+
+	/** Maximum number of free pickups kept per class. */
+	UPROPERTY(Config)
+	int32 MaxFreePickupsPerClass{64};
+
+private:
+	UPROPERTY()
+	TMap<UClass*, FPickupPool> Pools{};
+
+	ABasePickupItem* SpawnPickupActor(UClass* PickupClass, const FTransform& Transform) const;
+	void UpdateStats() const;
+};
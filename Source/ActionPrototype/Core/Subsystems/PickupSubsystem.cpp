@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PickupSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Actors/Pickups/BasePickupItem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Pickups"), STAT_RegisteredPickups, STATGROUP_ActionPrototype);
+
+void UPickupSubsystem::Deinitialize()
+{
+	Cells.Empty();
+	PickupCells.Empty();
+	SET_DWORD_STAT(STAT_RegisteredPickups, 0);
+	Super::Deinitialize();
+}
+
+void UPickupSubsystem::RegisterPickup(ABasePickupItem* Pickup)
+{
+	if (Pickup == nullptr || PickupCells.Contains(Pickup))
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCell(Pickup->GetActorLocation());
+	AddToCell(Pickup, Cell);
+	PickupCells.Add(Pickup, Cell);
+	SET_DWORD_STAT(STAT_RegisteredPickups, PickupCells.Num());
+	MaxPickupRadius = FMath::Max(MaxPickupRadius, Pickup->GetPickupRadius());
+}
+
+void UPickupSubsystem::UnregisterPickup(ABasePickupItem* Pickup)
+{
+	FIntPoint Cell;
+
+	if (!PickupCells.RemoveAndCopyValue(Pickup, Cell))
+	{
+		return;
+	}
+
+	RemoveFromCell(Pickup, Cell);
+	SET_DWORD_STAT(STAT_RegisteredPickups, PickupCells.Num());
+}
+
+void UPickupSubsystem::UpdatePickupLocation(ABasePickupItem* Pickup)
+{
+	FIntPoint* CurrentCell = PickupCells.Find(Pickup);
+
+	if (CurrentCell == nullptr)
+	{
+		return;
+	}
+
+	const FIntPoint NewCell = GetCell(Pickup->GetActorLocation());
+
+	if (NewCell == *CurrentCell)
+	{
+		return;
+	}
+
+	RemoveFromCell(Pickup, *CurrentCell);
+	AddToCell(Pickup, NewCell);
+	*CurrentCell = NewCell;
+}
+
+void UPickupSubsystem::QueryPickups(
+	const FVector& SegmentStart,
+	const FVector& SegmentEnd,
+	const float Radius,
+	TArray<ABasePickupItem*>& OutPickups) const
+{
+	OutPickups.Reset();
+
+	if (PickupCells.Num() == 0)
+	{
+		return;
+	}
+
+	const float QueryExtent = Radius + MaxPickupRadius;
+	const FVector BoundsMin = SegmentStart.ComponentMin(SegmentEnd) - FVector(QueryExtent);
+	const FVector BoundsMax = SegmentStart.ComponentMax(SegmentEnd) + FVector(QueryExtent);
+	const FIntPoint MinCell = GetCell(BoundsMin);
+	const FIntPoint MaxCell = GetCell(BoundsMax);
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TArray<ABasePickupItem*>* CellPickups = Cells.Find(FIntPoint(CellX, CellY));
+
+			if (CellPickups == nullptr)
+			{
+				continue;
+			}
+
+			for (ABasePickupItem* Pickup : *CellPickups)
+			{
+				const float MaxDistance = Radius + Pickup->GetPickupRadius();
+				const float DistanceSquared = FMath::PointDistToSegmentSquared(
+					 Pickup->GetActorLocation(),
+					 SegmentStart,
+					 SegmentEnd
+					);
+
+				if (DistanceSquared <= FMath::Square(MaxDistance))
+				{
+					OutPickups.Add(Pickup);
+				}
+			}
+		}
+	}
+}
+
+int32 UPickupSubsystem::GetPickupsNumber() const
+{
+	return PickupCells.Num();
+}
+
+FIntPoint UPickupSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UPickupSubsystem::AddToCell(ABasePickupItem* Pickup, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Pickup);
+}
+
+void UPickupSubsystem::RemoveFromCell(ABasePickupItem* Pickup, const FIntPoint& Cell)
+{
+	TArray<ABasePickupItem*>* CellPickups = Cells.Find(Cell);
+
+	if (CellPickups == nullptr)
+	{
+		return;
+	}
+
+	// Empty cells are kept to avoid reallocating them when magnetised pickups move between cells
+	CellPickups->RemoveSingleSwap(Pickup, false);
+}
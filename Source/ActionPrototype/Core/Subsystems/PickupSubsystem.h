@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupSubsystem.generated.h"
+
+class ABasePickupItem;
+
+/**
+ * Uniform 2D grid of active pickups.
+ * The player queries it around its capsule instead of relying on overlap events of every pickup.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API UPickupSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Adds a pickup to the grid cell of its current location. */
+	void RegisterPickup(ABasePickupItem* Pickup);
+	/** Removes a pickup from the grid. */
+	void UnregisterPickup(ABasePickupItem* Pickup);
+	/** Moves a pickup to another grid cell if its location has changed the cell. */
+	void UpdatePickupLocation(ABasePickupItem* Pickup);
+	/** Collects all pickups which collision spheres intersect the given swept sphere.
+	 * @param SegmentStart - start of the sphere sweep, the same as SegmentEnd for a sphere query;
+	 * @param SegmentEnd - end of the sphere sweep;
+	 * @param Radius - radius of the swept sphere;
+	 * @param OutPickups - result array, it's reset but keeps its allocation;
+	 */
+	void QueryPickups(
+		const FVector& SegmentStart,
+		const FVector& SegmentEnd,
+		const float Radius,
+		TArray<ABasePickupItem*>& OutPickups) const;
+
+	UFUNCTION(BlueprintPure, Category="Pickup Subsystem")
+	int32 GetPickupsNumber() const;
+
+private:
+	/** Size of a grid cell in world units. */
+	float CellSize{512.f};
+	/** The biggest pickup radius among registered pickups, used to extend queries. */
+	float MaxPickupRadius{0.f};
+	TMap<FIntPoint, TArray<ABasePickupItem*>> Cells{};
+	TMap<ABasePickupItem*, FIntPoint> PickupCells{};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(ABasePickupItem* Pickup, const FIntPoint& Cell);
+	void RemoveFromCell(ABasePickupItem* Pickup, const FIntPoint& Cell);
+};
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RandomSeedSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+
+void URandomSeedSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("APSeed="), WorldSeed))
+	{
+		UE_LOG(LogActionPrototype, Log, TEXT("World seed %d is set from the command line."), WorldSeed);
+		return;
+	}
+
+	const UWorld* World = GetWorld();
+	const FString MapName = World != nullptr ? UWorld::RemovePIEPrefix(World->GetMapName()) : FString{};
+	WorldSeed = static_cast<int32>(FCrc::StrCrc32(*MapName));
+	UE_LOG(LogActionPrototype, Log, TEXT("World seed %d is derived from map %s."), WorldSeed, *MapName);
+}
+
+FRandomStream URandomSeedSubsystem::MakeStream(const UObject* Object) const
+{
+	return FRandomStream{static_cast<int32>(HashCombine(static_cast<uint32>(WorldSeed), static_cast<uint32>(GetObjectSeed(Object))))};
+}
+
+FRandomStream URandomSeedSubsystem::MakeStreamFor(const UObject* Object)
+{
+	const UWorld* World = Object != nullptr ? Object->GetWorld() : nullptr;
+	const URandomSeedSubsystem* RandomSeedSubsystem = World != nullptr
+		                                                  ? World->GetSubsystem<URandomSeedSubsystem>()
+		                                                  : nullptr;
+
+	if (RandomSeedSubsystem == nullptr)
+	{
+		return FRandomStream{GetObjectSeed(Object)};
+	}
+
+	return RandomSeedSubsystem->MakeStream(Object);
+}
+
+int32 URandomSeedSubsystem::GetObjectSeed(const UObject* Object)
+{
+	// Names are stable between runs as long as actors are placed or spawned in the same order
+	return Object != nullptr ? static_cast<int32>(FCrc::StrCrc32(*Object->GetName())) : 0;
+}
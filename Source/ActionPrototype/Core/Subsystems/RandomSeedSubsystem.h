@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RandomSeedSubsystem.generated.h"
+
+/**
+ * Provides deterministic random streams derived from the world seed and actor names, so combat replays identically
+ * between runs. The seed is taken from the map name or can be overridden with -APSeed=<Number> on the command line.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API URandomSeedSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	UFUNCTION(BlueprintPure, Category="Random Seed")
+	FORCEINLINE int32 GetWorldSeed() const { return WorldSeed; }
+	/** Returns a stream seeded from the world seed and the name of the given object. */
+	FRandomStream MakeStream(const UObject* Object) const;
+
+	/** Returns a stream from the subsystem of the object's world or seeded from the object's name only. */
+	static FRandomStream MakeStreamFor(const UObject* Object);
+
+private:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Random Seed", meta=(AllowPrivateAccess="true"))
+	int32 WorldSeed{0};
+
+	static int32 GetObjectSeed(const UObject* Object);
+};
@@ -0,0 +1,460 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SaveGameSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Core/Subsystems/SubLevelStreamingSubsystem.h"
+#include "ActionPrototype/Interfaces/PersistentState.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "Misc/Compression.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Save Game Capture"), STAT_SaveGameCapture, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Save Game Apply"), STAT_SaveGameApply, STATGROUP_ActionPrototype);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Saved Actor States"), STAT_SavedActorStates, STATGROUP_ActionPrototype);
+
+static constexpr uint32 SaveDataMagic{0x41505356};
+/** Must be increased whenever the save layout or any SerializePersistentState layout changes. */
+static constexpr uint8 SaveDataVersion{1};
+
+void USaveGameSubsystem::Deinitialize()
+{
+	TrackedActors.Empty();
+	StoredStates.Empty();
+	LoadedStates.Empty();
+	PendingStates.Empty();
+	Super::Deinitialize();
+}
+
+void USaveGameSubsystem::Tick(float DeltaTime)
+{
+	if (LoadedStates.Num() > 0)
+	{
+		ApplyLoadedStates();
+	}
+}
+
+TStatId USaveGameSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USaveGameSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType USaveGameSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+UWorld* USaveGameSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void USaveGameSubsystem::RegisterActor(AActor* Actor)
+{
+	if (Actor == nullptr || !Actor->HasAnyFlags(RF_WasLoaded) || Cast<IPersistentState>(Actor) == nullptr)
+	{
+		return;
+	}
+
+	const FName Key = GetActorKey(Actor);
+	FTrackedActor& TrackedActor = TrackedActors.FindOrAdd(Key);
+	TrackedActor.Actor = Actor;
+	TrackedActor.Baseline.Reset();
+	WriteActorState(Actor, TrackedActor.Baseline);
+	// The delta kept when the actor's level was unloaded applies first, a state loaded since then overrides it
+	TArray<uint8> StoredState;
+
+	if (StoredStates.RemoveAndCopyValue(Key, StoredState))
+	{
+		ReadActorState(Actor, StoredState);
+	}
+
+	TArray<uint8> PendingState;
+
+	if (PendingStates.RemoveAndCopyValue(Key, PendingState))
+	{
+		ReadActorState(Actor, PendingState);
+	}
+}
+
+void USaveGameSubsystem::UnregisterActor(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	const FName Key = GetActorKey(Actor);
+	const FTrackedActor* TrackedActor = TrackedActors.Find(Key);
+
+	if (TrackedActor == nullptr || TrackedActor->Actor != Actor)
+	{
+		return;
+	}
+
+	TArray<uint8> State;
+	WriteActorState(Actor, State);
+
+	if (State != TrackedActor->Baseline)
+	{
+		StoredStates.Add(Key, MoveTemp(State));
+	}
+
+	TrackedActors.Remove(Key);
+}
+
+bool USaveGameSubsystem::SaveGame(const FString& SlotName)
+{
+	if (bIsSaving || IsLoading())
+	{
+		return false;
+	}
+
+	FActorStates States;
+
+	{
+		AP_SCOPE_CYCLE_COUNTER(STAT_SaveGameCapture);
+		States.Reserve(TrackedActors.Num() + StoredStates.Num() + PendingStates.Num());
+
+		for (const TPair<FName, TArray<uint8>>& StoredState : StoredStates)
+		{
+			States.Emplace(StoredState.Key.ToString(), StoredState.Value);
+		}
+
+		// Loaded states of actors which haven't been in play since loading are still a part of the game
+		for (const TPair<FName, TArray<uint8>>& PendingState : PendingStates)
+		{
+			States.Emplace(PendingState.Key.ToString(), PendingState.Value);
+		}
+
+		for (const TPair<FName, FTrackedActor>& TrackedActor : TrackedActors)
+		{
+			AActor* Actor = TrackedActor.Value.Actor.Get();
+
+			if (Actor == nullptr)
+			{
+				continue;
+			}
+
+			TArray<uint8> State;
+			WriteActorState(Actor, State);
+
+			if (State != TrackedActor.Value.Baseline)
+			{
+				States.Emplace(TrackedActor.Key.ToString(), MoveTemp(State));
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SavedActorStates, States.Num());
+	bIsSaving = true;
+	ISaveGameSystem* SaveGameSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	const int32 SaveUserIndex = UserIndex;
+	TWeakObjectPtr<USaveGameSubsystem> WeakThis{this};
+	Async(
+		  EAsyncExecution::ThreadPool,
+		  [WeakThis, SaveGameSystem, MapName, SlotName, SaveUserIndex, States = MoveTemp(States)]()
+		  {
+			  TArray<uint8> Data;
+			  const bool bIsSuccessful = SaveGameSystem != nullptr
+				  && WriteSaveData(MapName, States, Data)
+				  && SaveGameSystem->SaveGame(false, *SlotName, SaveUserIndex, Data);
+
+			  AsyncTask(
+						ENamedThreads::GameThread,
+						[WeakThis, bIsSuccessful]()
+						{
+							if (WeakThis.IsValid())
+							{
+								WeakThis->HandleGameSaved(bIsSuccessful);
+							}
+						}
+					   );
+		  }
+		 );
+	return true;
+}
+
+bool USaveGameSubsystem::LoadGame(const FString& SlotName)
+{
+	if (bIsSaving || IsLoading())
+	{
+		return false;
+	}
+
+	bIsLoading = true;
+	ISaveGameSystem* SaveGameSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	const int32 LoadUserIndex = UserIndex;
+	TWeakObjectPtr<USaveGameSubsystem> WeakThis{this};
+	Async(
+		  EAsyncExecution::ThreadPool,
+		  [WeakThis, SaveGameSystem, MapName, SlotName, LoadUserIndex]()
+		  {
+			  TArray<uint8> Data;
+			  FActorStates States;
+			  const bool bIsSuccessful = SaveGameSystem != nullptr
+				  && SaveGameSystem->LoadGame(false, *SlotName, LoadUserIndex, Data)
+				  && ReadSaveData(MapName, Data, States);
+
+			  AsyncTask(
+						ENamedThreads::GameThread,
+						[WeakThis, bIsSuccessful, States = MoveTemp(States)]() mutable
+						{
+							if (WeakThis.IsValid())
+							{
+								WeakThis->HandleGameLoaded(MoveTemp(States), bIsSuccessful);
+							}
+						}
+					   );
+		  }
+		 );
+	return true;
+}
+
+void USaveGameSubsystem::ApplyLoadedStates()
+{
+	AP_SCOPE_CYCLE_COUNTER(STAT_SaveGameApply);
+
+	const int32 BatchSize = FMath::Max(LoadBatchSize, 1);
+
+	for (int32 AppliedNumber = 0; AppliedNumber < BatchSize && LoadedStates.Num() > 0; ++AppliedNumber)
+	{
+		TPair<FString, TArray<uint8>> LoadedState = LoadedStates.Pop(false);
+		const FName Key{*LoadedState.Key};
+		const FTrackedActor* TrackedActor = TrackedActors.Find(Key);
+		AActor* Actor = TrackedActor != nullptr ? TrackedActor->Actor.Get() : nullptr;
+
+		if (Actor == nullptr)
+		{
+			PendingStates.Add(Key, MoveTemp(LoadedState.Value));
+			continue;
+		}
+
+		ReadActorState(Actor, LoadedState.Value);
+	}
+
+	if (LoadedStates.Num() == 0)
+	{
+		OnGameLoaded.Broadcast(true);
+	}
+}
+
+void USaveGameSubsystem::HandleGameSaved(const bool bIsSuccessful)
+{
+	bIsSaving = false;
+	AP_TRACE_EVENT(TEXT("Game saved"));
+
+	if (!bIsSuccessful)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Failed to save the game."));
+	}
+
+	OnGameSaved.Broadcast(bIsSuccessful);
+}
+
+void USaveGameSubsystem::HandleGameLoaded(FActorStates&& States, const bool bIsSuccessful)
+{
+	bIsLoading = false;
+	AP_TRACE_EVENT(TEXT("Game loaded"));
+
+	if (!bIsSuccessful)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Failed to load the game."));
+		OnGameLoaded.Broadcast(false);
+		return;
+	}
+
+	StoredStates.Empty();
+	PendingStates.Empty();
+	USubLevelStreamingSubsystem* SubLevelStreaming = GetWorld()->GetSubsystem<USubLevelStreamingSubsystem>();
+
+	if (SubLevelStreaming != nullptr)
+	{
+		SubLevelStreaming->ClearPersistentStates();
+	}
+
+	TSet<FString> LoadedKeys;
+	LoadedKeys.Reserve(States.Num());
+
+	for (const TPair<FString, TArray<uint8>>& State : States)
+	{
+		LoadedKeys.Add(State.Key);
+	}
+
+	// Actors changed since the save but not present in it are reverted to their level defaults
+	for (const TPair<FName, FTrackedActor>& TrackedActor : TrackedActors)
+	{
+		const FString Key = TrackedActor.Key.ToString();
+
+		if (!LoadedKeys.Contains(Key))
+		{
+			States.Emplace(Key, TrackedActor.Value.Baseline);
+		}
+	}
+
+	LoadedStates = MoveTemp(States);
+
+	if (LoadedStates.Num() == 0)
+	{
+		OnGameLoaded.Broadcast(true);
+	}
+}
+
+FName USaveGameSubsystem::GetActorKey(const AActor* Actor)
+{
+	return FName{*UWorld::RemovePIEPrefix(Actor->GetPathName())};
+}
+
+void USaveGameSubsystem::WriteActorState(AActor* Actor, TArray<uint8>& OutState)
+{
+	IPersistentState* PersistentState = Cast<IPersistentState>(Actor);
+
+	if (PersistentState == nullptr)
+	{
+		return;
+	}
+
+	FMemoryWriter Writer{OutState};
+	PersistentState->SerializePersistentState(Writer);
+}
+
+void USaveGameSubsystem::ReadActorState(AActor* Actor, const TArray<uint8>& State)
+{
+	IPersistentState* PersistentState = Cast<IPersistentState>(Actor);
+
+	if (PersistentState == nullptr || State.Num() == 0)
+	{
+		return;
+	}
+
+	FMemoryReader Reader{State};
+	PersistentState->SerializePersistentState(Reader);
+}
+
+bool USaveGameSubsystem::WriteSaveData(const FString& MapName, const FActorStates& States, TArray<uint8>& OutData)
+{
+	TArray<uint8> RawData;
+	FMemoryWriter RawWriter{RawData};
+	FString SavedMapName = MapName;
+	int32 StatesNumber = States.Num();
+	RawWriter << SavedMapName;
+	RawWriter << StatesNumber;
+
+	for (const TPair<FString, TArray<uint8>>& State : States)
+	{
+		FString Key = State.Key;
+		int32 StateSize = State.Value.Num();
+		RawWriter << Key;
+		RawWriter << StateSize;
+		RawWriter.Serialize(const_cast<uint8*>(State.Value.GetData()), StateSize);
+	}
+
+	int32 UncompressedSize = RawData.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+	TArray<uint8> CompressedData;
+	CompressedData.SetNumUninitialized(CompressedSize);
+
+	if (!FCompression::CompressMemory(
+									  NAME_Zlib,
+									  CompressedData.GetData(),
+									  CompressedSize,
+									  RawData.GetData(),
+									  UncompressedSize
+									 ))
+	{
+		return false;
+	}
+
+	CompressedData.SetNum(CompressedSize, false);
+	FMemoryWriter Writer{OutData};
+	uint32 Magic = SaveDataMagic;
+	uint8 Version = SaveDataVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << UncompressedSize;
+	Writer << CompressedData;
+	return !Writer.IsError();
+}
+
+bool USaveGameSubsystem::ReadSaveData(const FString& MapName, const TArray<uint8>& Data, FActorStates& OutStates)
+{
+	FMemoryReader Reader{Data};
+	uint32 Magic{0};
+	uint8 Version{0};
+	int32 UncompressedSize{0};
+	TArray<uint8> CompressedData;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Reader.IsError() || Magic != SaveDataMagic || Version != SaveDataVersion)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Save data has an unsupported version or is corrupted."));
+		return false;
+	}
+
+	Reader << UncompressedSize;
+	Reader << CompressedData;
+
+	if (Reader.IsError() || UncompressedSize <= 0)
+	{
+		return false;
+	}
+
+	TArray<uint8> RawData;
+	RawData.SetNumUninitialized(UncompressedSize);
+
+	if (!FCompression::UncompressMemory(
+										NAME_Zlib,
+										RawData.GetData(),
+										UncompressedSize,
+										CompressedData.GetData(),
+										CompressedData.Num()
+									   ))
+	{
+		return false;
+	}
+
+	FMemoryReader RawReader{RawData};
+	FString SavedMapName;
+	int32 StatesNumber{0};
+	RawReader << SavedMapName;
+	RawReader << StatesNumber;
+
+	if (SavedMapName != MapName)
+	{
+		UE_LOG(LogActionPrototype, Warning, TEXT("Save data belongs to map %s, not %s."), *SavedMapName, *MapName);
+		return false;
+	}
+
+	if (RawReader.IsError() || StatesNumber < 0 || StatesNumber > RawData.Num())
+	{
+		return false;
+	}
+
+	OutStates.Reserve(StatesNumber);
+
+	for (int32 Index = 0; Index < StatesNumber && !RawReader.IsError(); ++Index)
+	{
+		TPair<FString, TArray<uint8>>& State = OutStates.AddDefaulted_GetRef();
+		int32 StateSize{0};
+		RawReader << State.Key;
+		RawReader << StateSize;
+
+		if (StateSize < 0 || StateSize > RawReader.TotalSize() - RawReader.Tell())
+		{
+			return false;
+		}
+
+		State.Value.SetNumUninitialized(StateSize);
+		RawReader.Serialize(State.Value.GetData(), StateSize);
+	}
+
+	return !RawReader.IsError();
+}
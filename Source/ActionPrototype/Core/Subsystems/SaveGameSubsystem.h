@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SaveGameSubsystem.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameSaved, bool, bIsSuccessful);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameLoaded, bool, bIsSuccessful);
+
+/**
+ * Saves the state of IPersistentState actors placed in the level as a delta against their state on begin play,
+ * so only actors changed by the player are written. Compression and disk access happen on a worker thread,
+ * loaded states are applied in batches of LoadBatchSize actors per frame.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API USaveGameSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** Stores the baseline of the given IPersistentState actor and applies its loaded state if there is one.
+	 * Actors spawned at runtime are ignored, since they can't be matched between sessions.
+	 */
+	void RegisterActor(AActor* Actor);
+	/** Keeps the delta of the given actor, so it's saved after the actor is destroyed or its level is unloaded. */
+	void UnregisterActor(AActor* Actor);
+
+	/** Starts writing changed actors to the given slot, returns false if saving or loading is in progress. */
+	UFUNCTION(BlueprintCallable, Category="Save Game")
+	bool SaveGame(const FString& SlotName);
+	/** Starts reading the given slot, returns false if saving or loading is in progress. */
+	UFUNCTION(BlueprintCallable, Category="Save Game")
+	bool LoadGame(const FString& SlotName);
+	UFUNCTION(BlueprintPure, Category="Save Game")
+	FORCEINLINE bool IsSaving() const { return bIsSaving; }
+	UFUNCTION(BlueprintPure, Category="Save Game")
+	FORCEINLINE bool IsLoading() const { return bIsLoading || LoadedStates.Num() > 0; }
+
+	UPROPERTY(BlueprintAssignable, Category="Save Game|Delegates")
+	FOnGameSaved OnGameSaved;
+	/** Calls when all loaded states of present actors are applied. */
+	UPROPERTY(BlueprintAssignable, Category="Save Game|Delegates")
+	FOnGameLoaded OnGameLoaded;
+
+	/** Number of actors receiving their loaded state per frame. */
+	UPROPERTY(Config)
+	int32 LoadBatchSize{16};
+	UPROPERTY(Config)
+	int32 UserIndex{0};
+
+private:
+	struct FTrackedActor
+	{
+		TWeakObjectPtr<AActor> Actor{};
+		TArray<uint8> Baseline{};
+	};
+
+	using FActorStates = TArray<TPair<FString, TArray<uint8>>>;
+
+	TMap<FName, FTrackedActor> TrackedActors{};
+	/** Deltas of actors which aren't in play anymore. */
+	TMap<FName, TArray<uint8>> StoredStates{};
+	/** Loaded states waiting to be applied by Tick. */
+	FActorStates LoadedStates{};
+	/** Loaded states of actors which aren't in play yet, applied on registration. */
+	TMap<FName, TArray<uint8>> PendingStates{};
+
+	bool bIsSaving{false};
+	bool bIsLoading{false};
+
+	void ApplyLoadedStates();
+	void HandleGameSaved(const bool bIsSuccessful);
+	void HandleGameLoaded(FActorStates&& States, const bool bIsSuccessful);
+
+	static FName GetActorKey(const AActor* Actor);
+	static void WriteActorState(AActor* Actor, TArray<uint8>& OutState);
+	static void ReadActorState(AActor* Actor, const TArray<uint8>& State);
+	/** Builds the compressed save data, it's safe to call from any thread. */
+	static bool WriteSaveData(const FString& MapName, const FActorStates& States, TArray<uint8>& OutData);
+	/** Parses the compressed save data, it's safe to call from any thread. */
+	static bool ReadSaveData(const FString& MapName, const TArray<uint8>& Data, FActorStates& OutStates);
+};
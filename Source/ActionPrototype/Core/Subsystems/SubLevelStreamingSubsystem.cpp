@@ -0,0 +1,345 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SubLevelStreamingSubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Actors/SubLevelStreamingVolume.h"
+#include "ActionPrototype/Interfaces/PersistentState.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Kismet/GameplayStatics.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Loaded Sub-Levels"), STAT_LoadedSubLevels, STATGROUP_ActionPrototype);
+DECLARE_CYCLE_STAT(TEXT("Sub-Level Streaming Update"), STAT_SubLevelStreamingUpdate, STATGROUP_ActionPrototype);
+
+void USubLevelStreamingSubsystem::Deinitialize()
+{
+	Volumes.Empty();
+	ManagedLevels.Empty();
+	DesiredLevels.Empty();
+	RetainedLevels.Empty();
+	PersistentStates.Empty();
+	Super::Deinitialize();
+}
+
+void USubLevelStreamingSubsystem::Tick(float DeltaTime)
+{
+	AP_SCOPE_CYCLE_COUNTER(STAT_SubLevelStreamingUpdate);
+
+	if (Volumes.Num() == 0)
+	{
+		return;
+	}
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (PlayerPawn == nullptr)
+	{
+		return;
+	}
+
+	UpdateMemoryBudget(DeltaTime);
+	UpdateDesiredLevels(PlayerPawn->GetActorLocation());
+	// Unloading goes first, so memory is freed before new levels are requested
+	const int32 ChangesLimit = FMath::Max(MaxChangesPerFrame, 1);
+	const int32 ChangesNumber = UnloadLevels(ChangesLimit);
+	LoadLevels(ChangesLimit - ChangesNumber);
+	SET_DWORD_STAT(STAT_LoadedSubLevels, GetLoadedSubLevelsNumber());
+}
+
+TStatId USubLevelStreamingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USubLevelStreamingSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType USubLevelStreamingSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+UWorld* USubLevelStreamingSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void USubLevelStreamingSubsystem::RegisterVolume(ASubLevelStreamingVolume* Volume)
+{
+	if (Volume == nullptr || Volumes.Contains(Volume))
+	{
+		return;
+	}
+
+	Volumes.Add(Volume);
+	RebuildManagedLevels();
+}
+
+void USubLevelStreamingSubsystem::UnregisterVolume(ASubLevelStreamingVolume* Volume)
+{
+	if (Volumes.RemoveSingleSwap(Volume, false) > 0)
+	{
+		RebuildManagedLevels();
+	}
+}
+
+void USubLevelStreamingSubsystem::StorePersistentState(AActor* Actor)
+{
+	IPersistentState* PersistentState = Cast<IPersistentState>(Actor);
+
+	if (PersistentState == nullptr)
+	{
+		return;
+	}
+
+	TArray<uint8>& StateData = PersistentStates.FindOrAdd(GetPersistentStateKey(Actor));
+	StateData.Reset();
+	FMemoryWriter Writer{StateData};
+	PersistentState->SerializePersistentState(Writer);
+}
+
+void USubLevelStreamingSubsystem::RestorePersistentState(AActor* Actor)
+{
+	IPersistentState* PersistentState = Cast<IPersistentState>(Actor);
+
+	if (PersistentState == nullptr)
+	{
+		return;
+	}
+
+	const TArray<uint8>* StateData = PersistentStates.Find(GetPersistentStateKey(Actor));
+
+	if (StateData == nullptr)
+	{
+		return;
+	}
+
+	FMemoryReader Reader{*StateData};
+	PersistentState->SerializePersistentState(Reader);
+}
+
+void USubLevelStreamingSubsystem::ClearPersistentStates()
+{
+	PersistentStates.Empty();
+}
+
+int32 USubLevelStreamingSubsystem::GetLoadedSubLevelsNumber() const
+{
+	int32 LoadedLevelsNumber = 0;
+
+	for (const ULevelStreaming* StreamingLevel : GetWorld()->GetStreamingLevels())
+	{
+		if (StreamingLevel != nullptr && StreamingLevel->IsLevelLoaded()
+			&& ManagedLevels.Contains(GetStreamingLevelName(StreamingLevel)))
+		{
+			++LoadedLevelsNumber;
+		}
+	}
+
+	return LoadedLevelsNumber;
+}
+
+void USubLevelStreamingSubsystem::UpdateMemoryBudget(const float DeltaTime)
+{
+	if (MemoryBudgetMB <= 0)
+	{
+		bIsOverMemoryBudget = false;
+		return;
+	}
+
+	TimeSinceMemoryCheck += DeltaTime;
+
+	if (TimeSinceMemoryCheck < MemoryCheckInterval)
+	{
+		return;
+	}
+
+	TimeSinceMemoryCheck = 0.f;
+	const uint64 UsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+	const bool bWasOverMemoryBudget = bIsOverMemoryBudget;
+	bIsOverMemoryBudget = UsedMemory > static_cast<uint64>(MemoryBudgetMB) * 1024 * 1024;
+
+	if (bIsOverMemoryBudget && !bWasOverMemoryBudget)
+	{
+		UE_LOG(
+			   LogActionPrototype,
+			   Warning,
+			   TEXT("Sub-level streaming is over the memory budget: %.1f MB used, %d MB budget."),
+			   UsedMemory / (1024.0 * 1024.0),
+			   MemoryBudgetMB
+			  );
+	}
+}
+
+void USubLevelStreamingSubsystem::UpdateDesiredLevels(const FVector& PlayerLocation)
+{
+	DesiredLevels.Reset();
+	RetainedLevels.Reset();
+
+	for (const ASubLevelStreamingVolume* Volume : Volumes)
+	{
+		if (Volume == nullptr)
+		{
+			continue;
+		}
+
+		const bool bIsInside = Volume->ContainsLocation(PlayerLocation);
+
+		// Over the budget levels of left volumes are unloaded immediately
+		if (!bIsInside && (bIsOverMemoryBudget || !Volume->ContainsLocation(PlayerLocation, UnloadMargin)))
+		{
+			continue;
+		}
+
+		for (const TSoftObjectPtr<UWorld>& SubLevel : Volume->GetSubLevels())
+		{
+			const FName PackageName{*SubLevel.ToSoftObjectPath().GetLongPackageName()};
+
+			if (!bIsInside)
+			{
+				RetainedLevels.Add(PackageName);
+				continue;
+			}
+
+			int32* Priority = DesiredLevels.Find(PackageName);
+
+			if (Priority == nullptr)
+			{
+				DesiredLevels.Add(PackageName, Volume->GetPriority());
+			}
+			else
+			{
+				*Priority = FMath::Max(*Priority, Volume->GetPriority());
+			}
+		}
+	}
+
+	DesiredLevels.ValueSort(TGreater<int32>{});
+}
+
+int32 USubLevelStreamingSubsystem::UnloadLevels(const int32 ChangesLimit) const
+{
+	int32 ChangesNumber = 0;
+
+	for (ULevelStreaming* StreamingLevel : GetWorld()->GetStreamingLevels())
+	{
+		if (ChangesNumber >= ChangesLimit)
+		{
+			break;
+		}
+
+		if (StreamingLevel == nullptr || !StreamingLevel->ShouldBeLoaded())
+		{
+			continue;
+		}
+
+		const FName PackageName = GetStreamingLevelName(StreamingLevel);
+
+		if (!ManagedLevels.Contains(PackageName) || DesiredLevels.Contains(PackageName)
+			|| RetainedLevels.Contains(PackageName))
+		{
+			continue;
+		}
+
+		StreamingLevel->SetShouldBeVisible(false);
+		StreamingLevel->SetShouldBeLoaded(false);
+		++ChangesNumber;
+	}
+
+	return ChangesNumber;
+}
+
+int32 USubLevelStreamingSubsystem::LoadLevels(const int32 ChangesLimit)
+{
+	int32 ChangesNumber = 0;
+
+	for (const TPair<FName, int32>& DesiredLevel : DesiredLevels)
+	{
+		if (ChangesNumber >= ChangesLimit)
+		{
+			break;
+		}
+
+		ULevelStreaming* StreamingLevel = FindStreamingLevel(DesiredLevel.Key);
+
+		if (StreamingLevel == nullptr)
+		{
+			continue;
+		}
+
+		if (!StreamingLevel->ShouldBeLoaded())
+		{
+			if (bIsOverMemoryBudget)
+			{
+				continue;
+			}
+
+			StreamingLevel->bShouldBlockOnLoad = false;
+			StreamingLevel->SetShouldBeLoaded(true);
+			StreamingLevel->SetShouldBeVisible(true);
+			++ChangesNumber;
+		}
+		else if (!StreamingLevel->ShouldBeVisible())
+		{
+			StreamingLevel->SetShouldBeVisible(true);
+			++ChangesNumber;
+		}
+	}
+
+	return ChangesNumber;
+}
+
+void USubLevelStreamingSubsystem::RebuildManagedLevels()
+{
+	ManagedLevels.Reset();
+
+	for (const ASubLevelStreamingVolume* Volume : Volumes)
+	{
+		if (Volume == nullptr)
+		{
+			continue;
+		}
+
+		for (const TSoftObjectPtr<UWorld>& SubLevel : Volume->GetSubLevels())
+		{
+			const FName PackageName{*SubLevel.ToSoftObjectPath().GetLongPackageName()};
+			ManagedLevels.Add(PackageName);
+
+			if (FindStreamingLevel(PackageName) == nullptr)
+			{
+				UE_LOG(
+					   LogActionPrototype,
+					   Warning,
+					   TEXT("Sub-level %s of %s isn't a streaming level of the persistent level."),
+					   *PackageName.ToString(),
+					   *Volume->GetName()
+					  );
+			}
+		}
+	}
+}
+
+ULevelStreaming* USubLevelStreamingSubsystem::FindStreamingLevel(const FName PackageName) const
+{
+	for (ULevelStreaming* StreamingLevel : GetWorld()->GetStreamingLevels())
+	{
+		if (StreamingLevel != nullptr && GetStreamingLevelName(StreamingLevel) == PackageName)
+		{
+			return StreamingLevel;
+		}
+	}
+
+	return {nullptr};
+}
+
+FName USubLevelStreamingSubsystem::GetStreamingLevelName(const ULevelStreaming* StreamingLevel)
+{
+	return FName{*UWorld::RemovePIEPrefix(StreamingLevel->GetWorldAssetPackageName())};
+}
+
+FName USubLevelStreamingSubsystem::GetPersistentStateKey(const AActor* Actor)
+{
+	return FName{*UWorld::RemovePIEPrefix(Actor->GetPathName())};
+}
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SubLevelStreamingSubsystem.generated.h"
+
+class ASubLevelStreamingVolume;
+class ULevelStreaming;
+
+/**
+ * Streams sub-levels in and out by the player's proximity to ASubLevelStreamingVolume actors.
+ * Only MaxChangesPerFrame sub-levels change their state per frame, so the cost of adding and removing levels
+ * is spread across frames. Levels of volumes the player has left stay loaded within UnloadMargin unless the memory
+ * budget is exceeded. Also keeps the state of IPersistentState actors between unloading and loading of their levels.
+ */
+UCLASS(Config=Game)
+class ACTIONPROTOTYPE_API USubLevelStreamingSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	void RegisterVolume(ASubLevelStreamingVolume* Volume);
+	void UnregisterVolume(ASubLevelStreamingVolume* Volume);
+
+	/** Saves the state of the given IPersistentState actor, it should be called when the actor's level is removed. */
+	void StorePersistentState(AActor* Actor);
+	/** Applies the previously stored state to the given IPersistentState actor if there is one. */
+	void RestorePersistentState(AActor* Actor);
+	/** Drops all stored states, e.g. when a saved game replaces them. */
+	void ClearPersistentStates();
+
+	UFUNCTION(BlueprintPure, Category="Sub-Level Streaming")
+	int32 GetLoadedSubLevelsNumber() const;
+	UFUNCTION(BlueprintPure, Category="Sub-Level Streaming")
+	FORCEINLINE bool IsOverMemoryBudget() const { return bIsOverMemoryBudget; }
+
+	/** Distance from a volume within which its loaded sub-levels aren't unloaded, prevents thrashing on volume borders. */
+	UPROPERTY(Config)
+	float UnloadMargin{1024.f};
+	/** Used physical memory in MB above which new sub-levels aren't loaded. 0 disables the budget. */
+	UPROPERTY(Config)
+	int32 MemoryBudgetMB{0};
+	/** Sub-levels that start loading or unloading in one frame. */
+	UPROPERTY(Config)
+	int32 MaxChangesPerFrame{1};
+	/** Interval in seconds between memory budget checks. */
+	UPROPERTY(Config)
+	float MemoryCheckInterval{0.5f};
+
+private:
+	UPROPERTY()
+	TArray<ASubLevelStreamingVolume*> Volumes{};
+	/** Package names of all sub-levels referenced by the registered volumes. */
+	TSet<FName> ManagedLevels{};
+	/** Sub-levels of volumes containing the player, mapped to the highest volume priority. */
+	TMap<FName, int32> DesiredLevels{};
+	/** Sub-levels of volumes the player is near to. */
+	TSet<FName> RetainedLevels{};
+	TMap<FName, TArray<uint8>> PersistentStates{};
+
+	float TimeSinceMemoryCheck{0.f};
+	bool bIsOverMemoryBudget{false};
+
+	void UpdateMemoryBudget(const float DeltaTime);
+	void UpdateDesiredLevels(const FVector& PlayerLocation);
+	int32 UnloadLevels(const int32 ChangesLimit) const;
+	int32 LoadLevels(const int32 ChangesLimit);
+	void RebuildManagedLevels();
+	ULevelStreaming* FindStreamingLevel(const FName PackageName) const;
+
+	static FName GetStreamingLevelName(const ULevelStreaming* StreamingLevel);
+	static FName GetPersistentStateKey(const AActor* Actor);
+};
@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TickPolicySubsystem.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+void UTickPolicySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	CostStartFrame = GFrameCounter;
+}
+
+void UTickPolicySubsystem::Deinitialize()
+{
+	TickCosts.Empty();
+	Super::Deinitialize();
+}
+
+void UTickPolicySubsystem::ApplyTickPolicy(UObject* Object)
+{
+	if (Object != nullptr)
+	{
+		SetTickEnabled(Object, NeedsTick(Object));
+	}
+}
+
+bool UTickPolicySubsystem::NeedsTick(const UObject* Object)
+{
+	const ITickPolicy* TickPolicy = Cast<ITickPolicy>(Object);
+
+	if (TickPolicy == nullptr)
+	{
+		return true;
+	}
+
+	switch (TickPolicy->GetTickPolicy())
+	{
+		case EGameplayTickPolicy::Always:
+			return true;
+		case EGameplayTickPolicy::Never:
+			return false;
+		default:
+			return IsTickImplementedInBlueprint(Object);
+	}
+}
+
+bool UTickPolicySubsystem::IsTickImplementedInBlueprint(const UObject* Object)
+{
+	// Actors and components name their Blueprint Tick event the same
+	static const FName ReceiveTickName{TEXT("ReceiveTick")};
+	return Object != nullptr && Object->GetClass()->IsFunctionImplementedInScript(ReceiveTickName);
+}
+
+bool UTickPolicySubsystem::BeginTickCost(const UObject* Object)
+{
+	if (TimedObject != nullptr)
+	{
+		return false;
+	}
+
+	TimedObject = Object;
+	return true;
+}
+
+void UTickPolicySubsystem::EndTickCost(const UObject* Object, const double Seconds)
+{
+	TimedObject = nullptr;
+	FTickCost& Cost = TickCosts.FindOrAdd(Object->GetClass()->GetFName());
+	Cost.Seconds += Seconds;
+	++Cost.Calls;
+}
+
+TArray<FTickReportEntry> UTickPolicySubsystem::GetReportEntries() const
+{
+	TMap<FName, FTickReportEntry> EntriesByClass;
+	const auto AddTickingObject = [this, &EntriesByClass](const UObject* Object)
+	{
+		const FName ClassName = Object->GetClass()->GetFName();
+		FTickReportEntry* ExistingEntry = EntriesByClass.Find(ClassName);
+
+		if (ExistingEntry != nullptr)
+		{
+			++ExistingEntry->TickingNumber;
+			return;
+		}
+
+		FTickReportEntry& Entry = EntriesByClass.Add(ClassName);
+		Entry.ClassName = ClassName;
+		Entry.TickingNumber = 1;
+		const FTickCost* Cost = TickCosts.Find(ClassName);
+
+		if (Cost != nullptr)
+		{
+			Entry.TickSeconds = Cost->Seconds;
+			Entry.TickCalls = Cost->Calls;
+		}
+	};
+
+	for (TActorIterator<AActor> It{GetWorld()}; It; ++It)
+	{
+		const AActor* Actor = *It;
+
+		if (Actor->IsActorTickEnabled())
+		{
+			AddTickingObject(Actor);
+		}
+
+		for (const UActorComponent* Component : Actor->GetComponents())
+		{
+			if (Component != nullptr && Component->IsComponentTickEnabled())
+			{
+				AddTickingObject(Component);
+			}
+		}
+	}
+
+	TArray<FTickReportEntry> Entries;
+	EntriesByClass.GenerateValueArray(Entries);
+	Entries.Sort(
+				 [](const FTickReportEntry& First, const FTickReportEntry& Second)
+				 {
+					 if (First.TickSeconds != Second.TickSeconds)
+					 {
+						 return First.TickSeconds > Second.TickSeconds;
+					 }
+
+					 return First.TickingNumber > Second.TickingNumber;
+				 }
+				);
+	return Entries;
+}
+
+void UTickPolicySubsystem::LogReport()
+{
+	const TArray<FTickReportEntry> Entries = GetReportEntries();
+	const uint64 FramesNumber = FMath::Max<uint64>(GFrameCounter - CostStartFrame, 1);
+	int32 TickingNumber = 0;
+	double TickSeconds = 0.0;
+
+	for (const FTickReportEntry& Entry : Entries)
+	{
+		if (Entry.TickCalls == 0)
+		{
+			UE_LOG(LogActionPrototype, Log, TEXT("%-40s ticking: %5d, tick cost isn't timed"), *Entry.ClassName.ToString(), Entry.TickingNumber);
+		}
+		else
+		{
+			UE_LOG(
+				   LogActionPrototype,
+				   Log,
+				   TEXT("%-40s ticking: %5d, tick: %.3f ms per frame, %.4f ms per call"),
+				   *Entry.ClassName.ToString(),
+				   Entry.TickingNumber,
+				   Entry.TickSeconds * 1000.0 / FramesNumber,
+				   Entry.TickSeconds * 1000.0 / Entry.TickCalls
+				  );
+		}
+
+		TickingNumber += Entry.TickingNumber;
+		TickSeconds += Entry.TickSeconds;
+	}
+
+	UE_LOG(
+		   LogActionPrototype,
+		   Log,
+		   TEXT("Ticking objects: %d in %d classes, timed tick: %.3f ms per frame over %llu frames."),
+		   TickingNumber,
+		   Entries.Num(),
+		   TickSeconds * 1000.0 / FramesNumber,
+		   FramesNumber
+		  );
+	TickCosts.Reset();
+	CostStartFrame = GFrameCounter;
+}
+
+void UTickPolicySubsystem::SetTickEnabled(UObject* Object, const bool bIsEnabled)
+{
+	AActor* Actor = Cast<AActor>(Object);
+
+	if (Actor != nullptr)
+	{
+		Actor->SetActorTickEnabled(bIsEnabled);
+		return;
+	}
+
+	UActorComponent* Component = Cast<UActorComponent>(Object);
+
+	if (Component != nullptr)
+	{
+		Component->SetComponentTickEnabled(bIsEnabled);
+	}
+}
+
+FTickCostScope::FTickCostScope(const UObject* InObject)
+	: Object{InObject}
+{
+	if (Object == nullptr || !IsInGameThread())
+	{
+		return;
+	}
+
+	const UWorld* World = Object->GetWorld();
+	Subsystem = World != nullptr ? World->GetSubsystem<UTickPolicySubsystem>() : nullptr;
+
+	if (Subsystem != nullptr && !Subsystem->BeginTickCost(Object))
+	{
+		Subsystem = nullptr;
+	}
+
+	if (Subsystem != nullptr)
+	{
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+FTickCostScope::~FTickCostScope()
+{
+	if (Subsystem != nullptr)
+	{
+		Subsystem->EndTickCost(Object, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+	}
+}
+
+static void ReportTicks(UWorld* World)
+{
+	UTickPolicySubsystem* TickPolicy = World != nullptr ? World->GetSubsystem<UTickPolicySubsystem>() : nullptr;
+
+	if (TickPolicy != nullptr)
+	{
+		TickPolicy->LogReport();
+	}
+}
+
+static FAutoConsoleCommandWithWorld TickReportCommand(
+	TEXT("ap.Ticks.Report"),
+	TEXT("Logs every ticking actor and component of the world by class with the tick cost since the previous report."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&ReportTicks));
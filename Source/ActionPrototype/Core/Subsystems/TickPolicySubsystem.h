@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionPrototype/Interfaces/TickPolicy.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TickPolicySubsystem.generated.h"
+
+/** Ticking actors and components of a class in a world and the time spent in their Tick. */
+struct FTickReportEntry
+{
+	FName ClassName{NAME_None};
+	int32 TickingNumber{0};
+	/** Time of the Tick timed by AP_SCOPE_TICK_COST since the previous report, 0 if the class isn't timed. */
+	double TickSeconds{0.0};
+	int32 TickCalls{0};
+};
+
+/**
+ * Enables the tick of ITickPolicy actors and components only while it's needed: the policy of the class is Always
+ * or a Blueprint subclass implements Tick. ap.Ticks.Report lists every ticking object
+ * of the world by class with the cost of the timed Tick functions.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API UTickPolicySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Enables or disables the tick of the actor or component as its policy needs. Called on BeginPlay and when
+	 * an object disabled by pooling or dormancy becomes active again.
+	 */
+	static void ApplyTickPolicy(UObject* Object);
+	static bool NeedsTick(const UObject* Object);
+	static bool IsTickImplementedInBlueprint(const UObject* Object);
+
+	/** Returns true if the tick of the object is timed, nested Tick calls of a class hierarchy are timed once. */
+	bool BeginTickCost(const UObject* Object);
+	void EndTickCost(const UObject* Object, const double Seconds);
+	/** Returns ticking objects of the world sorted by the tick cost and number. */
+	TArray<FTickReportEntry> GetReportEntries() const;
+	/** Logs the report entries and starts a new measurement of the tick cost. */
+	void LogReport();
+
+private:
+	struct FTickCost
+	{
+		double Seconds{0.0};
+		int32 Calls{0};
+	};
+
+	TMap<FName, FTickCost> TickCosts{};
+	const UObject* TimedObject{nullptr};
+	uint64 CostStartFrame{0};
+
+	static void SetTickEnabled(UObject* Object, const bool bIsEnabled);
+};
+
+/** Adds the time of a Tick to the cost of the class of the ticking object. */
+class ACTIONPROTOTYPE_API FTickCostScope
+{
+public:
+	explicit FTickCostScope(const UObject* InObject);
+	~FTickCostScope();
+
+private:
+	UTickPolicySubsystem* Subsystem{nullptr};
+	const UObject* Object{nullptr};
+	uint64 StartCycles{0};
+};
+
+#if !UE_BUILD_SHIPPING
+#define AP_SCOPE_TICK_COST(Object) FTickCostScope ANONYMOUS_VARIABLE(TickCostScope){Object}
+#else
+#define AP_SCOPE_TICK_COST(Object)
+#endif
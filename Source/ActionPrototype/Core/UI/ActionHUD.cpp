@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActionHUD.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/BaseCharacter.h"
+#include "ActionPrototype/Core/Subsystems/CombatTextSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Text Draw"), STAT_CombatTextDraw, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Texts Drawn"), STAT_CombatTextsDrawn, STATGROUP_ActionPrototype);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Health Bars Drawn"), STAT_HealthBarsDrawn, STATGROUP_ActionPrototype);
+
+void AActionHUD::DrawHUD()
+{
+	Super::DrawHUD();
+	AP_SCOPE_CYCLE_COUNTER(STAT_CombatTextDraw);
+
+	const UCombatTextSubsystem* CombatText = GetWorld()->GetSubsystem<UCombatTextSubsystem>();
+
+	if (CombatText == nullptr || Canvas == nullptr || PlayerOwner == nullptr)
+	{
+		return;
+	}
+
+	FVector ViewLocation{FVector::ZeroVector};
+	FRotator ViewRotation{FRotator::ZeroRotator};
+	PlayerOwner->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	// Bars are drawn first, so numbers stay on top of them
+	DrawHealthBars(CombatText, ViewLocation, CurrentTime);
+	DrawCombatTexts(CombatText, ViewLocation, CurrentTime);
+}
+
+bool AActionHUD::ProjectLocation(const FVector& Location, const FVector& ViewLocation, FVector2D& OutScreenLocation) const
+{
+	if (CullDistance > 0.f && FVector::DistSquared(Location, ViewLocation) > FMath::Square(CullDistance))
+	{
+		return false;
+	}
+
+	const FVector ScreenLocation = Canvas->Project(Location);
+
+	// Canvas clamps the depth of locations behind the camera to 0
+	if (ScreenLocation.Z <= 0.f
+		|| ScreenLocation.X < 0.f
+		|| ScreenLocation.X > Canvas->ClipX
+		|| ScreenLocation.Y < 0.f
+		|| ScreenLocation.Y > Canvas->ClipY)
+	{
+		return false;
+	}
+
+	OutScreenLocation = FVector2D{ScreenLocation.X, ScreenLocation.Y};
+	return true;
+}
+
+void AActionHUD::DrawCombatTexts(
+	const UCombatTextSubsystem* CombatText,
+	const FVector& ViewLocation,
+	const float CurrentTime)
+{
+	UFont* Font = CombatTextFont != nullptr ? CombatTextFont : GEngine->GetMediumFont();
+	const float Duration = FMath::Max(CombatText->CombatTextDuration, KINDA_SMALL_NUMBER);
+
+	for (const FCombatTextEntry& Entry : CombatText->GetCombatTexts())
+	{
+		if (!CombatText->IsActive(Entry, CurrentTime))
+		{
+			continue;
+		}
+
+		const float Age = CurrentTime - Entry.StartTime;
+		FVector2D ScreenLocation{FVector2D::ZeroVector};
+
+		if (!ProjectLocation(Entry.Location + FVector{0.f, 0.f, CombatTextRiseSpeed * Age}, ViewLocation, ScreenLocation))
+		{
+			continue;
+		}
+
+		const FString Text = FString::FromInt(FMath::RoundToInt(Entry.Amount));
+		float TextWidth{0.f};
+		float TextHeight{0.f};
+		GetTextSize(Text, TextWidth, TextHeight, Font, CombatTextScale);
+
+		FLinearColor Color = CombatTextColor;
+		Color.A *= 1.f - Age / Duration;
+		DrawText(
+				 Text,
+				 Color,
+				 ScreenLocation.X - TextWidth * 0.5f,
+				 ScreenLocation.Y - TextHeight,
+				 Font,
+				 CombatTextScale
+				);
+		INC_DWORD_STAT(STAT_CombatTextsDrawn);
+	}
+}
+
+void AActionHUD::DrawHealthBars(
+	const UCombatTextSubsystem* CombatText,
+	const FVector& ViewLocation,
+	const float CurrentTime)
+{
+	for (const FHealthBarEntry& Entry : CombatText->GetHealthBars())
+	{
+		const ABaseCharacter* Character = Entry.Character.Get();
+
+		if (!CombatText->IsActive(Entry, CurrentTime) || Character->GetCurrentHealth() <= 0.f)
+		{
+			continue;
+		}
+
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		const float CapsuleHalfHeight = Capsule != nullptr ? Capsule->GetScaledCapsuleHalfHeight() : 0.f;
+		FVector2D ScreenLocation{FVector2D::ZeroVector};
+
+		if (!ProjectLocation(
+							 Character->GetActorLocation() + FVector{0.f, 0.f, CapsuleHalfHeight + HealthBarHeight},
+							 ViewLocation,
+							 ScreenLocation
+							))
+		{
+			continue;
+		}
+
+		const float Left = ScreenLocation.X - HealthBarSize.X * 0.5f;
+		const float Top = ScreenLocation.Y - HealthBarSize.Y * 0.5f;
+		DrawRect(HealthBarBackgroundColor, Left, Top, HealthBarSize.X, HealthBarSize.Y);
+		DrawRect(
+				 HealthBarColor,
+				 Left,
+				 Top,
+				 HealthBarSize.X * FMath::Clamp(Character->GetNormalisedHealth(), 0.f, 1.f),
+				 HealthBarSize.Y
+				);
+		INC_DWORD_STAT(STAT_HealthBarsDrawn);
+	}
+}
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/HUD.h"
+#include "ActionHUD.generated.h"
+
+class UCombatTextSubsystem;
+class UFont;
+
+/**
+ * Draws pooled damage numbers and health bars of UCombatTextSubsystem in a single canvas pass.
+ * Entries far from the view point or outside the screen are skipped.
+ */
+UCLASS()
+class ACTIONPROTOTYPE_API AActionHUD : public AHUD
+{
+	GENERATED_BODY()
+
+public:
+	virtual void DrawHUD() override;
+
+	/** If null the engine's medium font is used. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text")
+	UFont* CombatTextFont{nullptr};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text")
+	FLinearColor CombatTextColor{1.f, 0.85f, 0.2f, 1.f};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text", meta=(ClampMin="0.0"))
+	float CombatTextScale{1.f};
+	/** Units per second the damage numbers move up with. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text")
+	float CombatTextRiseSpeed{60.f};
+
+	/** Size of a health bar in pixels. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text|Health Bar")
+	FVector2D HealthBarSize{64.f, 6.f};
+	/** Offset from the top of the character's capsule. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text|Health Bar")
+	float HealthBarHeight{24.f};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text|Health Bar")
+	FLinearColor HealthBarColor{0.8f, 0.1f, 0.1f, 1.f};
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text|Health Bar")
+	FLinearColor HealthBarBackgroundColor{0.f, 0.f, 0.f, 0.5f};
+
+	/** Entries further than this distance from the view point aren't drawn. If == 0.0 culling is disabled. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat Text", meta=(ClampMin="0.0"))
+	float CullDistance{3000.f};
+
+private:
+	/** Returns false if the location is culled. */
+	bool ProjectLocation(const FVector& Location, const FVector& ViewLocation, FVector2D& OutScreenLocation) const;
+	void DrawCombatTexts(const UCombatTextSubsystem* CombatText, const FVector& ViewLocation, const float CurrentTime);
+	void DrawHealthBars(const UCombatTextSubsystem* CombatText, const FVector& ViewLocation, const float CurrentTime);
+};
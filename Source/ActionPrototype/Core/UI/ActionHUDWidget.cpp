@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActionHUDWidget.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Core/UI/PlayerHUDViewModel.h"
+#include "Components/ProgressBar.h"
+#include "Components/TextBlock.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD Widget Update"), STAT_HUDWidgetUpdate, STATGROUP_ActionPrototype);
+
+void UActionHUDWidget::SetViewModel(UPlayerHUDViewModel* NewViewModel)
+{
+	if (ViewModel == NewViewModel)
+	{
+		return;
+	}
+
+	UnbindViewModel();
+	ViewModel = NewViewModel;
+
+	if (ViewModel == nullptr)
+	{
+		return;
+	}
+
+	ViewModel->OnHealthChanged.AddDynamic(this, &UActionHUDWidget::HandleHealthChanged);
+	ViewModel->OnStaminaChanged.AddDynamic(this, &UActionHUDWidget::HandleStaminaChanged);
+	ViewModel->OnCoinsChanged.AddDynamic(this, &UActionHUDWidget::HandleCoinsChanged);
+
+	HandleHealthChanged(ViewModel->GetHealth(), ViewModel->GetMaxHealth());
+	HandleStaminaChanged(ViewModel->GetStamina(), ViewModel->GetMaxStamina());
+	HandleCoinsChanged(ViewModel->GetCoins());
+}
+
+void UActionHUDWidget::NativeDestruct()
+{
+	UnbindViewModel();
+	ViewModel = nullptr;
+	Super::NativeDestruct();
+}
+
+void UActionHUDWidget::HandleHealthChanged(const float CurrentValue, const float MaxValue)
+{
+	AP_SCOPE_CYCLE_COUNTER(STAT_HUDWidgetUpdate);
+
+	if (HealthBar != nullptr)
+	{
+		HealthBar->SetPercent(MaxValue > 0.f ? CurrentValue / MaxValue : 0.f);
+	}
+
+	OnHealthUpdated(CurrentValue, MaxValue);
+}
+
+void UActionHUDWidget::HandleStaminaChanged(const float CurrentValue, const float MaxValue)
+{
+	AP_SCOPE_CYCLE_COUNTER(STAT_HUDWidgetUpdate);
+
+	if (StaminaBar != nullptr)
+	{
+		StaminaBar->SetPercent(MaxValue > 0.f ? CurrentValue / MaxValue : 0.f);
+	}
+
+	OnStaminaUpdated(CurrentValue, MaxValue);
+}
+
+void UActionHUDWidget::HandleCoinsChanged(const int32 Coins)
+{
+	AP_SCOPE_CYCLE_COUNTER(STAT_HUDWidgetUpdate);
+
+	if (CoinsText != nullptr)
+	{
+		CoinsText->SetText(FText::AsNumber(FMath::Max(Coins, 0)));
+	}
+
+	OnCoinsUpdated(Coins);
+}
+
+void UActionHUDWidget::UnbindViewModel()
+{
+	if (ViewModel == nullptr)
+	{
+		return;
+	}
+
+	ViewModel->OnHealthChanged.RemoveDynamic(this, &UActionHUDWidget::HandleHealthChanged);
+	ViewModel->OnStaminaChanged.RemoveDynamic(this, &UActionHUDWidget::HandleStaminaChanged);
+	ViewModel->OnCoinsChanged.RemoveDynamic(this, &UActionHUDWidget::HandleCoinsChanged);
+}
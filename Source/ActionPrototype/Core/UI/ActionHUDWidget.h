@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "ActionHUDWidget.generated.h"
+
+class UPlayerHUDViewModel;
+class UProgressBar;
+class UTextBlock;
+
+/**
+ * Base class of the player HUD. Values are pushed from UPlayerHUDViewModel when they change,
+ * so the widget tree can be wrapped into an invalidation box and skip painting between updates.
+ */
+UCLASS(Abstract)
+class ACTIONPROTOTYPE_API UActionHUDWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Subscribes to the given view model and shows its current values. */
+	void SetViewModel(UPlayerHUDViewModel* NewViewModel);
+
+	UFUNCTION(BlueprintPure, Category="HUD")
+	FORCEINLINE UPlayerHUDViewModel* GetViewModel() const { return ViewModel; }
+
+protected:
+	virtual void NativeDestruct() override;
+
+	/** Called after the health bar is updated. */
+	UFUNCTION(BlueprintImplementableEvent, Category="HUD")
+	void OnHealthUpdated(const float CurrentHealth, const float MaxHealth);
+	/** Called after the stamina bar is updated. */
+	UFUNCTION(BlueprintImplementableEvent, Category="HUD")
+	void OnStaminaUpdated(const float CurrentStamina, const float MaxStamina);
+	/** Called after the coins text is updated. */
+	UFUNCTION(BlueprintImplementableEvent, Category="HUD")
+	void OnCoinsUpdated(const int32 Coins);
+
+private:
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(AllowPrivateAccess="true", BindWidgetOptional))
+	UProgressBar* HealthBar{nullptr};
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(AllowPrivateAccess="true", BindWidgetOptional))
+	UProgressBar* StaminaBar{nullptr};
+	UPROPERTY(BlueprintReadOnly, Category="HUD", meta=(AllowPrivateAccess="true", BindWidgetOptional))
+	UTextBlock* CoinsText{nullptr};
+
+	UPROPERTY()
+	UPlayerHUDViewModel* ViewModel{nullptr};
+
+	UFUNCTION()
+	void HandleHealthChanged(const float CurrentValue, const float MaxValue);
+	UFUNCTION()
+	void HandleStaminaChanged(const float CurrentValue, const float MaxValue);
+	UFUNCTION()
+	void HandleCoinsChanged(const int32 Coins);
+
+	void UnbindViewModel();
+};
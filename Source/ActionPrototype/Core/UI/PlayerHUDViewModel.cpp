@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlayerHUDViewModel.h"
+
+#include "ActionPrototype/ActionPrototype.h"
+#include "ActionPrototype/Characters/PlayerCharacter.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Value Updates"), STAT_HUDValueUpdates, STATGROUP_ActionPrototype);
+
+void UPlayerHUDViewModel::SetCharacter(APlayerCharacter* NewCharacter)
+{
+	APlayerCharacter* OldCharacter = Character.Get();
+
+	if (OldCharacter == NewCharacter && NewCharacter != nullptr)
+	{
+		return;
+	}
+
+	if (OldCharacter != nullptr)
+	{
+		OldCharacter->OnPlayerSpawned.RemoveDynamic(this, &UPlayerHUDViewModel::HandlePlayerSpawned);
+		OldCharacter->OnCurrentHealthIncreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		OldCharacter->OnCurrentHealthDecreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		OldCharacter->OnMaxHealthIncreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		OldCharacter->OnMaxHealthDecreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		OldCharacter->OnStaminaIncreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleStaminaChanged);
+		OldCharacter->OnStaminaDecreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleStaminaChanged);
+		OldCharacter->OnCoinsIncreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleCoinsChanged);
+		OldCharacter->OnCoinsDecreased.RemoveDynamic(this, &UPlayerHUDViewModel::HandleCoinsChanged);
+	}
+
+	Character = NewCharacter;
+
+	if (NewCharacter != nullptr)
+	{
+		NewCharacter->OnPlayerSpawned.AddDynamic(this, &UPlayerHUDViewModel::HandlePlayerSpawned);
+		NewCharacter->OnCurrentHealthIncreased.AddDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		NewCharacter->OnCurrentHealthDecreased.AddDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		NewCharacter->OnMaxHealthIncreased.AddDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		NewCharacter->OnMaxHealthDecreased.AddDynamic(this, &UPlayerHUDViewModel::HandleHealthChanged);
+		NewCharacter->OnStaminaIncreased.AddDynamic(this, &UPlayerHUDViewModel::HandleStaminaChanged);
+		NewCharacter->OnStaminaDecreased.AddDynamic(this, &UPlayerHUDViewModel::HandleStaminaChanged);
+		NewCharacter->OnCoinsIncreased.AddDynamic(this, &UPlayerHUDViewModel::HandleCoinsChanged);
+		NewCharacter->OnCoinsDecreased.AddDynamic(this, &UPlayerHUDViewModel::HandleCoinsChanged);
+	}
+
+	UpdateAll();
+}
+
+void UPlayerHUDViewModel::HandlePlayerSpawned()
+{
+	UpdateAll();
+}
+
+void UPlayerHUDViewModel::HandleHealthChanged(const float Amount, const float NewValue)
+{
+	UpdateHealth();
+}
+
+void UPlayerHUDViewModel::HandleStaminaChanged(const float Amount, const float NewValue)
+{
+	UpdateStamina();
+}
+
+void UPlayerHUDViewModel::HandleCoinsChanged(const int32 Amount, const int32 NewValue)
+{
+	UpdateCoins();
+}
+
+void UPlayerHUDViewModel::UpdateHealth()
+{
+	const APlayerCharacter* PlayerCharacter = Character.Get();
+	const float NewHealth = PlayerCharacter != nullptr ? PlayerCharacter->GetCurrentHealth() : 0.f;
+	const float NewMaxHealth = PlayerCharacter != nullptr ? PlayerCharacter->GetMaxHealth() : 0.f;
+
+	if (NewHealth == Health && NewMaxHealth == MaxHealth)
+	{
+		return;
+	}
+
+	Health = NewHealth;
+	MaxHealth = NewMaxHealth;
+	INC_DWORD_STAT(STAT_HUDValueUpdates);
+	OnHealthChanged.Broadcast(Health, MaxHealth);
+}
+
+void UPlayerHUDViewModel::UpdateStamina()
+{
+	const APlayerCharacter* PlayerCharacter = Character.Get();
+	const float NewStamina = PlayerCharacter != nullptr ? PlayerCharacter->GetCurrentStamina() : 0.f;
+	const float NewMaxStamina = PlayerCharacter != nullptr ? PlayerCharacter->GetMaxStamina() : 0.f;
+
+	if (NewStamina == Stamina && NewMaxStamina == MaxStamina)
+	{
+		return;
+	}
+
+	Stamina = NewStamina;
+	MaxStamina = NewMaxStamina;
+	INC_DWORD_STAT(STAT_HUDValueUpdates);
+	OnStaminaChanged.Broadcast(Stamina, MaxStamina);
+}
+
+void UPlayerHUDViewModel::UpdateCoins()
+{
+	const APlayerCharacter* PlayerCharacter = Character.Get();
+	const int32 NewCoins = PlayerCharacter != nullptr ? PlayerCharacter->GetCoins() : 0;
+
+	if (NewCoins == Coins)
+	{
+		return;
+	}
+
+	Coins = NewCoins;
+	INC_DWORD_STAT(STAT_HUDValueUpdates);
+	OnCoinsChanged.Broadcast(Coins);
+}
+
+void UPlayerHUDViewModel::UpdateAll()
+{
+	UpdateHealth();
+	UpdateStamina();
+	UpdateCoins();
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PlayerHUDViewModel.generated.h"
+
+class APlayerCharacter;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHUDResourceChanged, float, CurrentValue, float, MaxValue);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHUDCoinsChanged, int32, Coins);
+
+/**
+ * Mirrors the player's health, stamina and coins for the HUD.
+ * Subscribes to the character's delegates and broadcasts only when a displayed value actually changes,
+ * so widgets don't need per-frame property bindings.
+ */
+UCLASS(BlueprintType)
+class ACTIONPROTOTYPE_API UPlayerHUDViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Unsubscribes from the previous character, subscribes to the new one and broadcasts all values. */
+	void SetCharacter(APlayerCharacter* NewCharacter);
+
+	UFUNCTION(BlueprintPure, Category="HUD")
+	FORCEINLINE float GetHealth() const { return Health; }
+
+	UFUNCTION(BlueprintPure, Category="HUD")
+	FORCEINLINE float GetMaxHealth() const { return MaxHealth; }
+
+	UFUNCTION(BlueprintPure, Category="HUD")
+	FORCEINLINE float GetStamina() const { return Stamina; }
+
+	UFUNCTION(BlueprintPure, Category="HUD")
+	FORCEINLINE float GetMaxStamina() const { return MaxStamina; }
+
+	UFUNCTION(BlueprintPure, Category="HUD")
+	FORCEINLINE int32 GetCoins() const { return Coins; }
+
+	UPROPERTY(BlueprintAssignable, Category="HUD")
+	FOnHUDResourceChanged OnHealthChanged;
+	UPROPERTY(BlueprintAssignable, Category="HUD")
+	FOnHUDResourceChanged OnStaminaChanged;
+	UPROPERTY(BlueprintAssignable, Category="HUD")
+	FOnHUDCoinsChanged OnCoinsChanged;
+
+private:
+	TWeakObjectPtr<APlayerCharacter> Character{nullptr};
+
+	float Health{-1.f};
+	float MaxHealth{-1.f};
+	float Stamina{-1.f};
+	float MaxStamina{-1.f};
+	int32 Coins{-1};
+
+	/** Values restored from a snapshot don't broadcast, so everything is refreshed once the player is spawned. */
+	UFUNCTION()
+	void HandlePlayerSpawned();
+	UFUNCTION()
+	void HandleHealthChanged(const float Amount, const float NewValue);
+	UFUNCTION()
+	void HandleStaminaChanged(const float Amount, const float NewValue);
+	UFUNCTION()
+	void HandleCoinsChanged(const int32 Amount, const int32 NewValue);
+
+	void UpdateHealth();
+	void UpdateStamina();
+	void UpdateCoins();
+	void UpdateAll();
+};
@@ -0,0 +1,7 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PersistentState.h"
+
+
+// Add default functionality here for any IPersistentState functions that are not pure virtual.
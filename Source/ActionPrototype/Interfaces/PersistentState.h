@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UObject/Interface.h"
+#include "PersistentState.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(meta=(CannotImplementInterfaceInBlueprint))
+class UPersistentState : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by level actors which keep their state when their streaming level is unloaded and loaded again.
+ */
+class ACTIONPROTOTYPE_API IPersistentState
+{
+	GENERATED_BODY()
+
+public:
+	/** Writes the state to the archive or reads and applies it, depending on Archive.IsLoading(). */
+	virtual void SerializePersistentState(FArchive& Archive) = 0;
+};
@@ -0,0 +1,7 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TickPolicy.h"
+
+
+// Add default functionality here for any ITickPolicy functions that are not pure virtual.
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UObject/Interface.h"
+#include "TickPolicy.generated.h"
+
+UENUM(BlueprintType)
+enum class EGameplayTickPolicy : uint8
+{
+	/** Ticks while a Blueprint subclass implements Tick. */
+	OnDemand,
+	/** Always ticks, used by classes whose Tick does work in C++. */
+	Always,
+	/** Never ticks, even if a Blueprint subclass implements Tick. */
+	Never
+};
+
+// This class does not need to be modified.
+UINTERFACE(meta=(CannotImplementInterfaceInBlueprint))
+class UTickPolicy : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by actors and components which start with the tick disabled. UTickPolicySubsystem enables the tick
+ * only when the policy of the class needs it.
+ */
+class ACTIONPROTOTYPE_API ITickPolicy
+{
+	GENERATED_BODY()
+
+public:
+	virtual EGameplayTickPolicy GetTickPolicy() const = 0;
+};